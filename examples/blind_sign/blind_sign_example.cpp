@@ -9,8 +9,9 @@ namespace libcrypt {
 bool anon_voting_call_example(const cxxopts::ParseResult& parse_cmd_line)
 {
     const uint8_t answer = parse_cmd_line["answer"].as<uint8_t>();
+    const unsigned threads_num = parse_cmd_line["threads"].as<unsigned>();
 
-    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys(threads_num);
 
     libcrypt::Server server;
     libcrypt::Elector alice(answer);
@@ -26,7 +27,7 @@ bool anon_voting_call_example(const cxxopts::ParseResult& parse_cmd_line)
 
     secure_channel.seekg(std::ios::beg);
 
-    libcrypt::Server::send_blinded_sign(params.mod, params.user.private_key, secure_channel);
+    libcrypt::Server::send_blinded_sign(params.private_key, secure_channel);
 
     secure_channel.clear();
     secure_channel.seekg(std::ios::beg);
@@ -15,6 +15,8 @@ void cipher_call_example(const cxxopts::ParseResult& parse_cmd_line)
     const std::filesystem::path message_path = parse_cmd_line["message"].as<std::string>();
     const std::filesystem::path encrypt_path = parse_cmd_line["encrypt"].as<std::string>();
     const std::filesystem::path decrypt_path = parse_cmd_line["decrypt"].as<std::string>();
+    const unsigned threads_num = parse_cmd_line["threads"].as<unsigned>();
+    const libcrypt::cipher_options options{threads_num, libcrypt::default_block_size, true};
 
     std::ifstream message_file(message_path, std::ios::binary);
     if (!message_file.is_open())
@@ -36,27 +38,28 @@ void cipher_call_example(const cxxopts::ParseResult& parse_cmd_line)
 
     if (parse_cmd_line.count("shamir"))
     {
-        libcrypt::shamir_sys_params params = libcrypt::shamir_gen_sys();
+        libcrypt::shamir_sys_params params = libcrypt::shamir_gen_sys(threads_num);
 
         libcrypt::shamir_encrypt(
-            params.mod, params.recv.private_key, params.send.private_key, message_file, encryption_file);
+            params.mod, params.recv.private_key, params.send.private_key, message_file, encryption_file, options);
 
         encryption_file.seekp(0, std::ios::beg);
 
         libcrypt::shamir_decrypt(
-            params.mod, params.recv.shared_key, params.send.shared_key, encryption_file, decryption_file);
+            params.mod, params.recv.shared_key, params.send.shared_key, encryption_file, decryption_file, options);
     }
 
     if (parse_cmd_line.count("elgamal"))
     {
-        libcrypt::elgamal_sys_params params = libcrypt::elgamal_gen_sys();
+        libcrypt::elgamal_sys_params params = libcrypt::elgamal_gen_sys(threads_num);
 
         libcrypt::elgamal_encrypt(
-            params.dh_sys_params, params.session_key, params.user.shared_key, message_file, encryption_file);
+            params.dh_sys_params, params.session_key, params.user.shared_key, message_file, encryption_file, options);
 
         encryption_file.seekp(0, std::ios::beg);
 
-        libcrypt::elgamal_decrypt(params.dh_sys_params.mod, params.user.private_key, encryption_file, decryption_file);
+        libcrypt::elgamal_decrypt(
+            params.dh_sys_params.mod, params.user.private_key, encryption_file, decryption_file, options);
     }
 
     if (parse_cmd_line.count("vernam"))
@@ -83,25 +86,25 @@ void cipher_call_example(const cxxopts::ParseResult& parse_cmd_line)
 
         vernam_key_file.seekp(0, std::ios::beg);
 
-        libcrypt::vernam_encrypt(vernam_key_file, message_file, encryption_file);
+        libcrypt::vernam_encrypt(vernam_key_file, message_file, encryption_file, options);
 
         encryption_file.seekp(0, std::ios::beg);
         vernam_key_file.seekp(0, std::ios::beg);
 
-        libcrypt::vernam_decrypt(vernam_key_file, encryption_file, decryption_file);
+        libcrypt::vernam_decrypt(vernam_key_file, encryption_file, decryption_file, options);
 
         vernam_key_file.close();
     }
 
     if (parse_cmd_line.count("rsa"))
     {
-        libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+        libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys(threads_num);
 
-        libcrypt::rsa_encrypt(params.mod, params.user.shared_key, message_file, encryption_file);
+        libcrypt::rsa_encrypt(params.mod, params.user.shared_key, message_file, encryption_file, options);
 
         encryption_file.seekp(0, std::ios::beg);
 
-        libcrypt::rsa_decrypt(params.mod, params.user.private_key, encryption_file, decryption_file);
+        libcrypt::rsa_decrypt(params.private_key, encryption_file, decryption_file, options);
     }
 
     message_file.close();
@@ -1,15 +1,16 @@
 #include <params/gen_params.hpp>
 #include <libcrypt/utils.hpp>
+#include <libcrypt/parallel_search.hpp>
 #include <random>
-#include <vector>
 #include <cstdint>
+#include <bit>
 
 namespace libcrypt {
 
 static libcrypt::crypt_user_params shamir_gen_user_params(int64_t mod)
 {
     int64_t private_key = 0;
-    std::vector<int64_t> gcd_result;
+    int64_t shared_key = 0;
 
     std::random_device rd;
     std::mt19937 mt(rd());
@@ -18,30 +19,34 @@ static libcrypt::crypt_user_params shamir_gen_user_params(int64_t mod)
     do
     {
         private_key = private_key_range(mt);
-        gcd_result = libcrypt::extended_gcd(mod - 1, private_key);
-    } while (gcd_result.front() != 1);
+        shared_key = libcrypt::inverse_mod(private_key, mod - 1);
+    } while (shared_key < 0);
 
-    int64_t shared_key = gcd_result.back();
+    return {private_key, shared_key};
+}
+
+// below this many bits a prime turns up in microseconds, faster than threads start
+constexpr int parallel_prime_min_bits = 24;
 
-    if (shared_key < 0)
+static int64_t gen_prime(int64_t min_prime, int64_t max_prime, unsigned threads_num)
+{
+    if (std::bit_width(static_cast<uint64_t>(max_prime)) < libcrypt::parallel_prime_min_bits)
     {
-        shared_key += mod - 1;
+        threads_num = 1;
     }
 
-    return {private_key, shared_key};
+    return libcrypt::parallel_search(
+        [=](std::mt19937& mt) {
+            std::uniform_int_distribution<int64_t> prime_range(min_prime, max_prime);
+            const int64_t candidate = prime_range(mt);
+            return libcrypt::is_prime(candidate) ? candidate : -1;
+        },
+        threads_num);
 }
 
-libcrypt::shamir_sys_params shamir_gen_sys()
+libcrypt::shamir_sys_params shamir_gen_sys(unsigned threads_num)
 {
-    int64_t mod = 0;
-    std::random_device rd;
-    std::mt19937 mt(rd());
-    std::uniform_int_distribution<int64_t> mod_range(INT16_MAX, INT32_MAX);
-
-    do
-    {
-        mod = mod_range(mt);
-    } while (!libcrypt::is_prime(mod));
+    const int64_t mod = libcrypt::gen_prime(INT16_MAX, INT32_MAX, threads_num);
 
     const libcrypt::crypt_user_params sender_params = libcrypt::shamir_gen_user_params(mod);
     const libcrypt::crypt_user_params reciever_params = libcrypt::shamir_gen_user_params(mod);
@@ -49,9 +54,9 @@ libcrypt::shamir_sys_params shamir_gen_sys()
     return {sender_params, reciever_params, mod};
 }
 
-libcrypt::elgamal_sys_params elgamal_gen_sys()
+libcrypt::elgamal_sys_params elgamal_gen_sys(unsigned threads_num)
 {
-    libcrypt::dh_system_params dh_sys_params = libcrypt::gen_dh_system();
+    libcrypt::dh_system_params dh_sys_params = libcrypt::gen_dh_system(threads_num);
 
     std::random_device rd;
     std::mt19937 mt(rd());
@@ -60,80 +65,60 @@ libcrypt::elgamal_sys_params elgamal_gen_sys()
 
     int64_t session_key = 0;
     int64_t recv_private_key = private_key_range(mt);
-    int64_t recv_shared_key = libcrypt::pow_mod(dh_sys_params.base, recv_private_key, dh_sys_params.mod);
+    int64_t recv_shared_key = libcrypt::pow_mod(
+        dh_sys_params.base, recv_private_key, dh_sys_params.mod, libcrypt::pow_mode::constant_time);
 
     do
     {
         session_key = session_key_range(mt);
-    } while (libcrypt::extended_gcd(session_key, dh_sys_params.mod - 1).front() != 1);
+    } while (libcrypt::binary_gcd(session_key, dh_sys_params.mod - 1) != 1);
 
     return {dh_sys_params, {recv_private_key, recv_shared_key}, session_key};
 }
 
-libcrypt::rsa_sys_params rsa_gen_sys()
+libcrypt::rsa_sys_params rsa_gen_sys(unsigned threads_num)
 {
     constexpr int64_t recv_shared_key = 3;
-    std::vector<int64_t> gcd_result;
-
-    std::random_device rd;
-    std::mt19937 mt(rd());
-    std::uniform_int_distribution<int64_t> prime_gen_range(UINT8_MAX, INT16_MAX);
 
     int64_t mod_part_P = 0;
     int64_t mod_part_Q = 0;
-    int64_t euler_func_res = 0;
+    int64_t recv_private_key = 0;
 
     do
     {
-        do
-        {
-            mod_part_P = prime_gen_range(mt);
-        } while (!libcrypt::is_prime(mod_part_P));
+        mod_part_P = libcrypt::gen_prime(UINT8_MAX, INT16_MAX, threads_num);
 
         do
         {
-            mod_part_Q = prime_gen_range(mt);
-        } while (!libcrypt::is_prime(mod_part_Q) || (mod_part_Q == mod_part_P));
+            mod_part_Q = libcrypt::gen_prime(UINT8_MAX, INT16_MAX, threads_num);
+        } while (mod_part_Q == mod_part_P);
 
-        euler_func_res = (mod_part_P - 1) * (mod_part_Q - 1);
-        gcd_result = libcrypt::extended_gcd(recv_shared_key, euler_func_res);
-    } while (gcd_result.front() != 1);
+        recv_private_key = libcrypt::inverse_mod(recv_shared_key, (mod_part_P - 1) * (mod_part_Q - 1));
+    } while (recv_private_key < 0);
 
     int64_t mod = mod_part_P * mod_part_Q;
-    int64_t recv_private_key = gcd_result.back();
-
-    if (recv_private_key < 0)
-    {
-        recv_private_key += euler_func_res;
-    }
+    libcrypt::rsa_private_key private_key = libcrypt::make_rsa_private_key(mod_part_P, mod_part_Q, recv_private_key);
 
-    return {{recv_private_key, recv_shared_key}, mod};
+    return {{recv_private_key, recv_shared_key}, mod, private_key};
 }
 
-libcrypt::gost_sys_params gost_gen_sys()
+libcrypt::gost_sys_params gost_gen_sys(unsigned threads_num)
 {
     std::random_device rd;
     std::mt19937 mt(rd());
-    std::uniform_int_distribution<int64_t> elliptic_exp_gen_range(UINT16_MAX / 2 + 1, UINT16_MAX);
 
-    int64_t elliptic_exp = 0;
+    const int64_t elliptic_exp = libcrypt::gen_prime(UINT16_MAX / 2 + 1, UINT16_MAX, threads_num);
 
-    do
-    {
-        elliptic_exp = elliptic_exp_gen_range(mt);
-    } while (!libcrypt::is_prime(elliptic_exp));
-
-    std::uniform_int_distribution<int64_t> tmp_elliptic_coef_gen_range(
-        INT32_MAX / (2 * elliptic_exp) + 1, INT32_MAX / elliptic_exp - 1);
+    const int64_t tmp_elliptic_coef = libcrypt::parallel_search(
+        [=](std::mt19937& coef_mt) {
+            std::uniform_int_distribution<int64_t> tmp_elliptic_coef_gen_range(
+                INT32_MAX / (2 * elliptic_exp) + 1, INT32_MAX / elliptic_exp - 1);
+            const int64_t candidate = tmp_elliptic_coef_gen_range(coef_mt);
+            return libcrypt::is_prime(candidate * elliptic_exp + 1) ? candidate : -1;
+        },
+        threads_num);
 
-    int64_t tmp_elliptic_coef = 0;
-    int64_t mod = 0;
-
-    do
-    {
-        tmp_elliptic_coef = tmp_elliptic_coef_gen_range(mt);
-        mod = tmp_elliptic_coef * elliptic_exp + 1;
-    } while (!libcrypt::is_prime(mod));
+    const int64_t mod = tmp_elliptic_coef * elliptic_exp + 1;
 
     std::uniform_int_distribution<int64_t> tmp_base_gen_range(1, mod - 1);
 
@@ -149,7 +134,8 @@ libcrypt::gost_sys_params gost_gen_sys()
     std::uniform_int_distribution<int64_t> private_key_gen_range(1, elliptic_exp - 1);
 
     int64_t send_private_key = private_key_gen_range(mt);
-    int64_t send_shared_key = libcrypt::pow_mod(elliptic_coef, send_private_key, mod);
+    int64_t send_shared_key
+        = libcrypt::pow_mod(elliptic_coef, send_private_key, mod, libcrypt::pow_mode::constant_time);
 
     return {{send_private_key, send_shared_key}, elliptic_exp, elliptic_coef, mod};
 }
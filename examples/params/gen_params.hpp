@@ -1,5 +1,6 @@
 #pragma once
 #include <libcrypt/utils.hpp>
+#include <libcrypt/rsa_crt.hpp>
 #include <cstdint>
 
 namespace libcrypt {
@@ -28,6 +29,7 @@ struct rsa_sys_params
 {
     libcrypt::crypt_user_params user;
     int64_t mod;
+    libcrypt::rsa_private_key private_key;
 };
 
 struct gost_sys_params
@@ -38,12 +40,12 @@ struct gost_sys_params
     int64_t mod;
 };
 
-libcrypt::shamir_sys_params shamir_gen_sys();
+libcrypt::shamir_sys_params shamir_gen_sys(unsigned threads_num = 1);
 
-libcrypt::elgamal_sys_params elgamal_gen_sys();
+libcrypt::elgamal_sys_params elgamal_gen_sys(unsigned threads_num = 1);
 
-libcrypt::rsa_sys_params rsa_gen_sys();
+libcrypt::rsa_sys_params rsa_gen_sys(unsigned threads_num = 1);
 
-libcrypt::gost_sys_params gost_gen_sys();
+libcrypt::gost_sys_params gost_gen_sys(unsigned threads_num = 1);
 
 }  // namespace libcrypt
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+#include <params/gen_params.hpp>
+#include <libcrypt/utils.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace libcrypt {
+
+// Bounded queue of ready-made system parameters, kept full by a background thread.
+// take() pops or waits for the next set, try_take() never blocks. A generator error is rethrown by the next take()
+// or try_take() that finds the queue empty, after which refilling goes on.
+template <typename Params>
+class ParamsPool
+{
+   public:
+    using generator = std::function<Params()>;
+
+    ParamsPool(generator gen, std::size_t capacity) : gen(std::move(gen)), capacity(capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::runtime_error{"Params pool capacity must be positive"};
+        }
+
+        refiller = std::jthread([this](std::stop_token stop) { refill(stop); });
+    }
+
+    ParamsPool(const ParamsPool&) = delete;
+    ParamsPool& operator=(const ParamsPool&) = delete;
+
+    std::optional<Params> try_take()
+    {
+        std::unique_lock lock(mutex);
+
+        if (ready.empty())
+        {
+            if (refill_error)
+            {
+                rethrow_refill_error(lock);
+            }
+            return std::nullopt;
+        }
+
+        return pop(lock);
+    }
+
+    Params take()
+    {
+        std::unique_lock lock(mutex);
+        changed.wait(lock, [this] { return !ready.empty() || refill_error; });
+
+        if (ready.empty())
+        {
+            rethrow_refill_error(lock);
+        }
+
+        return pop(lock);
+    }
+
+    std::size_t size() const
+    {
+        const std::lock_guard lock(mutex);
+        return ready.size();
+    }
+
+   private:
+    // the refiller waits for the error to be delivered before it tries again
+    [[noreturn]] void rethrow_refill_error(std::unique_lock<std::mutex>& lock)
+    {
+        const std::exception_ptr error = std::exchange(refill_error, nullptr);
+
+        lock.unlock();
+        changed.notify_all();
+
+        std::rethrow_exception(error);
+    }
+
+    Params pop(std::unique_lock<std::mutex>& lock)
+    {
+        Params params = std::move(ready.front());
+        ready.pop_front();
+
+        lock.unlock();
+        changed.notify_all();
+
+        return params;
+    }
+
+    void refill(std::stop_token stop)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock lock(mutex);
+                // after a failure wait until a taker has seen the error, a broken generator shouldn't spin
+                if (!changed.wait(lock, stop, [this] { return ready.size() < capacity && !refill_error; }))
+                {
+                    return;
+                }
+            }
+
+            try
+            {
+                Params params = gen();
+
+                const std::lock_guard lock(mutex);
+                ready.emplace_back(std::move(params));
+            }
+            catch (...)
+            {
+                const std::lock_guard lock(mutex);
+                refill_error = std::current_exception();
+            }
+
+            changed.notify_all();
+        }
+    }
+
+    generator gen;
+    std::size_t capacity;
+    std::deque<Params> ready;
+    std::exception_ptr refill_error;
+    mutable std::mutex mutex;
+    std::condition_variable_any changed;
+    std::jthread refiller;
+};
+
+using DhParamsPool = libcrypt::ParamsPool<libcrypt::dh_system_params>;
+using RsaParamsPool = libcrypt::ParamsPool<libcrypt::rsa_sys_params>;
+using GostParamsPool = libcrypt::ParamsPool<libcrypt::gost_sys_params>;
+
+inline libcrypt::DhParamsPool make_dh_params_pool(std::size_t capacity, unsigned threads_num = 1)
+{
+    return {[threads_num] { return libcrypt::gen_dh_system(threads_num); }, capacity};
+}
+
+inline libcrypt::RsaParamsPool make_rsa_params_pool(std::size_t capacity, unsigned threads_num = 1)
+{
+    return {[threads_num] { return libcrypt::rsa_gen_sys(threads_num); }, capacity};
+}
+
+inline libcrypt::GostParamsPool make_gost_params_pool(std::size_t capacity, unsigned threads_num = 1)
+{
+    return {[threads_num] { return libcrypt::gost_gen_sys(threads_num); }, capacity};
+}
+
+}  // namespace libcrypt
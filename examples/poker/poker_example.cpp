@@ -15,13 +15,14 @@ void poker_call_example(const cxxopts::ParseResult& parse_cmd_line)
     constexpr uint8_t max_players = 10;
     constexpr uint8_t board_size = 5;
     const uint8_t players_num = parse_cmd_line["players"].as<uint8_t>();
+    const unsigned threads_num = parse_cmd_line["threads"].as<unsigned>();
 
     if (players_num > max_players || players_num < 2)
     {
         throw std::runtime_error{"Number of players must be in range 2<=X<=10"};
     }
 
-    int64_t mod = libcrypt::gen_germain_prime() * 2 + 1;
+    int64_t mod = libcrypt::gen_germain_prime(threads_num) * 2 + 1;
 
     std::deque<int64_t> card_deck;
 
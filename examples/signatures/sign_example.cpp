@@ -12,6 +12,7 @@ namespace libcrypt {
 bool sign_call_example(const cxxopts::ParseResult& parse_cmd_line)
 {
     const std::filesystem::path signature_filepath = parse_cmd_line["sign_file"].as<std::string>();
+    const unsigned threads_num = parse_cmd_line["threads"].as<unsigned>();
 
     std::fstream sign_file(signature_filepath, std::ios::binary | std::ios::out | std::ios::in | std::ios::app);
     if (!sign_file.is_open())
@@ -21,9 +22,9 @@ bool sign_call_example(const cxxopts::ParseResult& parse_cmd_line)
 
     if (parse_cmd_line.count("rsa"))
     {
-        libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+        libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys(threads_num);
 
-        libcrypt::rsa_file_signing(params.mod, params.user.private_key, sign_file);
+        libcrypt::rsa_file_signing(params.private_key, sign_file);
 
         sign_file.seekg(std::ios::beg);
 
@@ -32,7 +33,7 @@ bool sign_call_example(const cxxopts::ParseResult& parse_cmd_line)
 
     if (parse_cmd_line.count("elgamal"))
     {
-        libcrypt::elgamal_sys_params params = libcrypt::elgamal_gen_sys();
+        libcrypt::elgamal_sys_params params = libcrypt::elgamal_gen_sys(threads_num);
 
         libcrypt::elgamal_file_signing(params.dh_sys_params, params.session_key, params.user.private_key, sign_file);
 
@@ -43,7 +44,7 @@ bool sign_call_example(const cxxopts::ParseResult& parse_cmd_line)
 
     if (parse_cmd_line.count("gost"))
     {
-        libcrypt::gost_sys_params params = libcrypt::gost_gen_sys();
+        libcrypt::gost_sys_params params = libcrypt::gost_gen_sys(threads_num);
 
         libcrypt::gost_file_signing(
             params.mod, params.elliptic_exp, params.elliptic_coef, params.user.private_key, sign_file);
@@ -1,4 +1,5 @@
 #pragma once
+#include <libcrypt/rsa_crt.hpp>
 #include <cstdint>
 #include <fstream>
 #include <unordered_set>
@@ -47,6 +48,8 @@ class Server
 
     static void send_blinded_sign(int64_t mod, int64_t server_private_key, std::fstream& secure_channel);
 
+    static void send_blinded_sign(const libcrypt::rsa_private_key& server_private_key, std::fstream& secure_channel);
+
     static bool check_bulletin(int64_t mod, int64_t server_shared_key, std::fstream& anonymous_channel);
 };
 
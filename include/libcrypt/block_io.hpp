@@ -0,0 +1,105 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace libcrypt {
+
+constexpr std::size_t default_block_size = 64 * 1024;
+
+template <typename T>
+class BlockReader
+{
+    std::istream& stream;
+    std::vector<T> buffer;
+
+   public:
+    explicit BlockReader(std::istream& input, std::size_t block_size = libcrypt::default_block_size)
+        : stream(input), buffer(std::max<std::size_t>(block_size / sizeof(T), 1))
+    {
+    }
+
+    // empty span means the end of the stream; a trailing partial element is dropped
+    std::span<const T> next(std::size_t max_count)
+    {
+        if (max_count > buffer.size())
+        {
+            buffer.resize(max_count);
+        }
+
+        stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(max_count * sizeof(T)));
+
+        return {buffer.data(), static_cast<std::size_t>(stream.gcount()) / sizeof(T)};
+    }
+
+    std::span<const T> next()
+    {
+        return next(buffer.size());
+    }
+};
+
+// reads up to max_count whole elements into block, false once the stream is exhausted
+template <typename T>
+bool read_block(std::istream& input, std::vector<T>& block, std::size_t max_count)
+{
+    block.resize(max_count);
+    input.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(max_count * sizeof(T)));
+    block.resize(static_cast<std::size_t>(input.gcount()) / sizeof(T));
+
+    return !block.empty();
+}
+
+template <typename T>
+class BlockWriter
+{
+    std::ostream& stream;
+    std::vector<T> buffer;
+    std::size_t filled = 0;
+
+   public:
+    explicit BlockWriter(std::ostream& output, std::size_t block_size = libcrypt::default_block_size)
+        : stream(output), buffer(std::max<std::size_t>(block_size / sizeof(T), 1))
+    {
+    }
+
+    BlockWriter(const BlockWriter&) = delete;
+    BlockWriter& operator=(const BlockWriter&) = delete;
+
+    ~BlockWriter()
+    {
+        flush();
+    }
+
+    void write(std::span<const T> data)
+    {
+        if (filled + data.size() > buffer.size())
+        {
+            flush();
+        }
+
+        if (data.size() >= buffer.size())
+        {
+            stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size_bytes()));
+            return;
+        }
+
+        std::copy(data.begin(), data.end(), buffer.begin() + static_cast<std::ptrdiff_t>(filled));
+        filled += data.size();
+    }
+
+    void flush()
+    {
+        if (filled == 0)
+        {
+            return;
+        }
+
+        stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(filled * sizeof(T)));
+        filled = 0;
+    }
+};
+
+}  // namespace libcrypt
@@ -0,0 +1,175 @@
+#pragma once
+#include <libcrypt/block_io.hpp>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace libcrypt {
+
+class ByteSource
+{
+   public:
+    virtual ~ByteSource() = default;
+
+    // fills at most buffer.size() bytes, returns 0 only at the end of the source
+    virtual std::size_t read(std::span<char> buffer) = 0;
+};
+
+class ByteSink
+{
+   public:
+    virtual ~ByteSink() = default;
+
+    virtual void write(std::span<const char> data) = 0;
+
+    // returns once everything written so far has reached the destination
+    virtual void flush() = 0;
+};
+
+class StreamSource : public libcrypt::ByteSource
+{
+    std::istream& stream;
+
+   public:
+    explicit StreamSource(std::istream& input) : stream(input) {}
+
+    std::size_t read(std::span<char> buffer) override;
+};
+
+class StreamSink : public libcrypt::ByteSink
+{
+    std::ostream& stream;
+
+   public:
+    explicit StreamSink(std::ostream& output) : stream(output) {}
+
+    void write(std::span<const char> data) override;
+
+    void flush() override;
+};
+
+class UringQueue;
+
+// false when the platform or the kernel (e.g. a seccomp filter) doesn't let us create an io_uring, or when the kernel
+// predates plain io_uring reads and writes (before Linux 5.6)
+bool io_uring_supported();
+
+// Reads a regular file through io_uring, keeping queue_depth reads of buffer_size bytes in flight ahead of the
+// consumer. Reading starts at the descriptor's current offset and doesn't move it. Falls back to plain pread when
+// io_uring isn't available or queue_depth is 0.
+class FileSource : public libcrypt::ByteSource
+{
+    struct slot
+    {
+        std::vector<char> buffer;
+        std::size_t filled = 0;
+        std::size_t consumed = 0;
+        int64_t offset = 0;
+        bool in_flight = false;
+    };
+
+    int fd;
+    int64_t next_offset;
+    std::unique_ptr<libcrypt::UringQueue> queue;
+    std::vector<slot> slots;
+    std::size_t current = 0;
+    bool end = false;
+
+    void submit(std::size_t index);
+
+    void complete_one();
+
+   public:
+    explicit FileSource(int fd, std::size_t buffer_size = libcrypt::default_block_size, unsigned queue_depth = 4);
+
+    FileSource(const FileSource&) = delete;
+    FileSource& operator=(const FileSource&) = delete;
+
+    ~FileSource() override;
+
+    std::size_t read(std::span<char> buffer) override;
+
+    bool is_async() const
+    {
+        return queue != nullptr;
+    }
+};
+
+// Writes a regular file through io_uring with up to queue_depth buffers of buffer_size bytes in flight, starting at
+// the descriptor's current offset. Falls back to plain pwrite like FileSource.
+class FileSink : public libcrypt::ByteSink
+{
+    struct slot
+    {
+        std::vector<char> buffer;
+        std::size_t filled = 0;
+        std::size_t written = 0;
+        int64_t offset = 0;
+        bool in_flight = false;
+    };
+
+    int fd;
+    int64_t next_offset;
+    std::unique_ptr<libcrypt::UringQueue> queue;
+    std::vector<slot> slots;
+    std::size_t current = 0;
+
+    void submit(std::size_t index);
+
+    void complete_one();
+
+    void wait_for(std::size_t index);
+
+   public:
+    explicit FileSink(int fd, std::size_t buffer_size = libcrypt::default_block_size, unsigned queue_depth = 4);
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    // flushes; call flush() first to see write errors
+    ~FileSink() override;
+
+    void write(std::span<const char> data) override;
+
+    void flush() override;
+
+    bool is_async() const
+    {
+        return queue != nullptr;
+    }
+};
+
+// reads up to max_count whole elements into block, false once the source is exhausted
+template <typename T>
+bool read_block(libcrypt::ByteSource& source, std::vector<T>& block, std::size_t max_count)
+{
+    block.resize(max_count);
+
+    const std::span<char> bytes{reinterpret_cast<char*>(block.data()), max_count * sizeof(T)};
+    std::size_t filled = 0;
+
+    while (filled < bytes.size())
+    {
+        const std::size_t count = source.read(bytes.subspan(filled));
+        if (count == 0)
+        {
+            break;
+        }
+        filled += count;
+    }
+
+    block.resize(filled / sizeof(T));
+
+    return !block.empty();
+}
+
+template <typename T>
+void write_block(libcrypt::ByteSink& sink, std::span<const T> block)
+{
+    sink.write({reinterpret_cast<const char*>(block.data()), block.size_bytes()});
+}
+
+}  // namespace libcrypt
@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <bitset>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+namespace libcrypt {
+
+constexpr std::size_t byte_values_num = 1 << CHAR_BIT;
+
+// Entries are computed on first use, so short streams never pay for the whole table
+class ByteEncryptionTable
+{
+    std::function<int64_t(int64_t)> encrypt_byte;
+    std::array<int32_t, byte_values_num> table{};
+    std::bitset<byte_values_num> filled;
+
+   public:
+    explicit ByteEncryptionTable(std::function<int64_t(int64_t)> byte_transform);
+
+    int32_t operator()(char message_part)
+    {
+        const auto index = static_cast<unsigned char>(message_part);
+
+        if (!filled.test(index))
+        {
+            table[index] = static_cast<int32_t>(encrypt_byte(static_cast<int64_t>(message_part)));
+            filled.set(index);
+        }
+
+        return table[index];
+    }
+};
+
+// Deterministic ciphers map at most byte_values_num ciphertexts back to bytes
+class ByteDecryptionTable
+{
+    std::function<int64_t(int64_t)> decrypt_word;
+    std::unordered_map<int32_t, char> table;
+
+   public:
+    explicit ByteDecryptionTable(std::function<int64_t(int64_t)> word_transform);
+
+    char operator()(int32_t encrypted_part);
+};
+
+}  // namespace libcrypt
@@ -0,0 +1,243 @@
+#pragma once
+#include <libcrypt/block_io.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libcrypt {
+
+struct cipher_options
+{
+    unsigned threads_num = 1;
+    std::size_t chunk_size = libcrypt::default_block_size;  // in bytes of input
+    bool overlap_io = false;  // read ahead and write behind on their own threads even with a single worker
+};
+
+// Three-stage pipeline: a reader thread prefetches chunks, threads_num workers compute them and the calling thread
+// writes them back in read order. At most 2 * threads_num + 2 chunks are in flight; their slots are reused once
+// written, so memory stays bounded and one chunk can be read and another written while the workers are busy.
+// With one thread and no overlap_io everything runs serially on the calling thread. With no threads and overlap_io
+// only the reader gets a thread: the calling thread computes each chunk right before writing it, which suits cheap
+// computations that just want the next read to overlap them.
+//   read_chunk(Chunk&) -> bool        fills the next chunk, false at the end of input; only called by the reader
+//   compute_chunk(Chunk&, worker)    worker is in [0, max(threads_num, 1)), for per-thread state
+//   write_chunk(Chunk&)              called in the same order the chunks were read
+template <typename Chunk, typename Read, typename Compute, typename Write>
+void process_chunks_in_order(
+    unsigned threads_num,
+    bool overlap_io,
+    Read read_chunk,
+    Compute compute_chunk,
+    Write write_chunk)
+{
+    if (threads_num <= 1 && !overlap_io)
+    {
+        Chunk chunk;
+        while (read_chunk(chunk))
+        {
+            compute_chunk(chunk, 0);
+            write_chunk(chunk);
+        }
+        return;
+    }
+
+    const unsigned workers_num = threads_num;
+    const bool compute_on_writer = workers_num == 0;
+    const std::size_t slots_num = 2 * static_cast<std::size_t>(workers_num) + 2;
+    std::vector<Chunk> slots(slots_num);
+    std::vector<bool> computed(slots_num);
+    std::deque<std::size_t> pending;
+    std::size_t read_count = 0;
+    std::size_t write_count = 0;
+    bool input_end = false;
+    bool finished = false;
+    std::exception_ptr error;
+
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable chunk_computed;
+    std::condition_variable slot_free;
+
+    const auto fail = [&](std::exception_ptr stage_error) {
+        {
+            const std::lock_guard lock(mutex);
+            if (!error)
+            {
+                error = stage_error;
+            }
+        }
+        chunk_computed.notify_all();
+    };
+
+    const auto worker_loop = [&](unsigned worker) {
+        while (true)
+        {
+            std::size_t index = 0;
+            {
+                std::unique_lock lock(mutex);
+                work_ready.wait(lock, [&] { return !pending.empty() || finished; });
+
+                if (pending.empty())
+                {
+                    return;
+                }
+
+                index = pending.front();
+                pending.pop_front();
+            }
+
+            try
+            {
+                compute_chunk(slots[index % slots_num], worker);
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+                continue;
+            }
+
+            {
+                const std::lock_guard lock(mutex);
+                computed[index % slots_num] = true;
+            }
+            chunk_computed.notify_all();
+        }
+    };
+
+    const auto reader_loop = [&] {
+        try
+        {
+            while (true)
+            {
+                std::size_t index = 0;
+                {
+                    std::unique_lock lock(mutex);
+                    slot_free.wait(lock, [&] { return read_count - write_count < slots_num || finished; });
+
+                    if (finished)
+                    {
+                        return;
+                    }
+
+                    index = read_count;
+                }
+
+                // the slot was written out already and nobody else touches it until it is pending
+                const bool has_chunk = read_chunk(slots[index % slots_num]);
+
+                {
+                    const std::lock_guard lock(mutex);
+                    if (has_chunk)
+                    {
+                        computed[index % slots_num] = false;
+                        if (!compute_on_writer)
+                        {
+                            pending.push_back(index);
+                        }
+                        read_count++;
+                    }
+                    else
+                    {
+                        input_end = true;
+                    }
+                }
+
+                if (!has_chunk)
+                {
+                    chunk_computed.notify_all();
+                    return;
+                }
+
+                if (compute_on_writer)
+                {
+                    chunk_computed.notify_all();
+                }
+                else
+                {
+                    work_ready.notify_one();
+                }
+            }
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    std::jthread reader;
+
+    const auto stop_stages = [&] {
+        {
+            const std::lock_guard lock(mutex);
+            finished = true;
+            pending.clear();
+        }
+        work_ready.notify_all();
+        slot_free.notify_all();
+
+        if (reader.joinable())
+        {
+            reader.join();
+        }
+        workers.clear();
+    };
+
+    try
+    {
+        workers.reserve(workers_num);
+        for (unsigned worker = 0; worker < workers_num; worker++)
+        {
+            workers.emplace_back(worker_loop, worker);
+        }
+        reader = std::jthread{reader_loop};
+
+        while (true)
+        {
+            {
+                std::unique_lock lock(mutex);
+                chunk_computed.wait(lock, [&] {
+                    return error
+                           || (write_count < read_count && (compute_on_writer || computed[write_count % slots_num]))
+                           || (input_end && write_count == read_count);
+                });
+
+                if (error || write_count == read_count)
+                {
+                    break;
+                }
+            }
+
+            if (compute_on_writer)
+            {
+                compute_chunk(slots[write_count % slots_num], 0);
+            }
+            write_chunk(slots[write_count % slots_num]);
+
+            {
+                const std::lock_guard lock(mutex);
+                write_count++;
+            }
+            slot_free.notify_one();
+        }
+    }
+    catch (...)
+    {
+        stop_stages();
+        throw;
+    }
+
+    stop_stages();
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace libcrypt
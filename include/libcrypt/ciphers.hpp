@@ -1,39 +1,254 @@
 #pragma once
 #include <libcrypt/utils.hpp>
+#include <libcrypt/rsa_crt.hpp>
+#include <libcrypt/chunk_pipeline.hpp>
+#include <libcrypt/byte_stream.hpp>
 #include <fstream>
 #include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <filesystem>
 
 namespace libcrypt {
 
+// Holds the per-stream ElGamal mask, so every byte costs one modular multiplication. A sender session keeps
+// y^k and only encrypts, a receiver session keeps (a^x)^(-1) and only decrypts; the other direction throws.
+class ElgamalSession
+{
+    libcrypt::MontgomeryContext ctx;
+    int64_t ciphertext_first;
+    uint64_t mont_mask;
+    bool sender;
+
+    void require_role(bool need_sender) const
+    {
+        if (sender != need_sender)
+        {
+            throw std::runtime_error{
+                sender ? "ElGamal sender session can't decrypt" : "ElGamal receiver session can't encrypt"};
+        }
+    }
+
+    int64_t mul_signed(int64_t value, uint64_t mont_factor) const
+    {
+        // plain * montgomery form reduces straight back to plain form; sign follows operator%
+        const uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        const auto result = static_cast<int64_t>(ctx.reduce(static_cast<libcrypt::uint128_t>(magnitude) * mont_factor));
+        return value < 0 ? -result : result;
+    }
+
+   public:
+    ElgamalSession(libcrypt::dh_system_params sys_params, int64_t session_key, int64_t recv_shared_key);
+
+    ElgamalSession(int64_t mod, int64_t recv_private_key, int64_t ciphertext_first);
+
+    int64_t get_ciphertext_first() const
+    {
+        return ciphertext_first;
+    }
+
+    int64_t encrypt(int64_t message_part) const
+    {
+        require_role(true);
+        return mul_signed(message_part, mont_mask);
+    }
+
+    int64_t decrypt(int64_t encrypted_part) const
+    {
+        require_role(false);
+        return mul_signed(encrypted_part, mont_mask);
+    }
+
+    // the output span must be at least as long as the input
+    void encrypt(std::span<const char> message, std::span<int32_t> encrypted) const;
+
+    void decrypt(std::span<const int32_t> encrypted, std::span<char> message) const;
+};
+
 void shamir_encrypt(
     int64_t mod,
     int64_t recv_private_key,
     int64_t send_private_key,
     std::ifstream& message_file,
-    std::fstream& encrypt_file);
+    std::fstream& encrypt_file,
+    const libcrypt::cipher_options& options = {});
 
 void shamir_decrypt(
     int64_t mod,
     int64_t recv_shared_key,
     int64_t send_shared_key,
     std::fstream& encrypt_file,
-    std::ofstream& decrypt_file);
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options = {});
 
 void elgamal_encrypt(
     libcrypt::dh_system_params sys_params,
     int64_t session_key,
     int64_t recv_shared_key,
     std::ifstream& message_file,
+    std::fstream& encrypt_file,
+    const libcrypt::cipher_options& options = {});
+
+void elgamal_decrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options = {});
+
+void vernam_encrypt(
+    std::fstream& vernam_key_file,
+    std::ifstream& message_file,
+    std::fstream& encrypt_file,
+    const libcrypt::cipher_options& options = {});
+
+void vernam_decrypt(
+    std::fstream& vernam_key_file,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options = {});
+
+// zero-copy variants: message, key and output are memory mapped and xored directly between mappings
+
+// writes to a uniquely named temporary file next to encrypt_path and renames it over encrypt_path, keeping its
+// permissions, so a failure leaves encrypt_path untouched
+void vernam_encrypt_mapped(
+    const std::filesystem::path& vernam_key_path,
+    const std::filesystem::path& message_path,
+    const std::filesystem::path& encrypt_path);
+
+// encrypt_fd must be opened O_RDWR, a writable shared mapping needs read access too; it's resized to the message
+// size from offset 0 and must not refer to the key or message file
+void vernam_encrypt_mapped(int vernam_key_fd, int message_fd, int encrypt_fd);
+
+void vernam_decrypt_mapped(
+    const std::filesystem::path& vernam_key_path,
+    const std::filesystem::path& encrypt_path,
+    const std::filesystem::path& decrypt_path);
+
+void vernam_decrypt_mapped(int vernam_key_fd, int encrypt_fd, int decrypt_fd);
+
+void rsa_encrypt(
+    int64_t mod,
+    int64_t recv_shared_key,
+    std::ifstream& message_file,
+    std::fstream& encrypt_file,
+    const libcrypt::cipher_options& options = {});
+
+void rsa_decrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options = {});
+
+void rsa_decrypt(
+    const libcrypt::rsa_private_key& recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options = {});
+
+// Byte source and sink variants, e.g. over libcrypt::FileSource and libcrypt::FileSink to keep several large
+// io_uring reads and writes in flight. The fstream functions above are thin adapters over these.
+
+void shamir_encrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    int64_t send_private_key,
+    libcrypt::ByteSource& message,
+    libcrypt::ByteSink& encrypted,
+    const libcrypt::cipher_options& options = {});
+
+void shamir_decrypt(
+    int64_t mod,
+    int64_t recv_shared_key,
+    int64_t send_shared_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options = {});
+
+void elgamal_encrypt(
+    libcrypt::dh_system_params sys_params,
+    int64_t session_key,
+    int64_t recv_shared_key,
+    libcrypt::ByteSource& message,
+    libcrypt::ByteSink& encrypted,
+    const libcrypt::cipher_options& options = {});
+
+void elgamal_decrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options = {});
+
+void vernam_encrypt(
+    libcrypt::ByteSource& vernam_key,
+    libcrypt::ByteSource& message,
+    libcrypt::ByteSink& encrypted,
+    const libcrypt::cipher_options& options = {});
+
+void vernam_decrypt(
+    libcrypt::ByteSource& vernam_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options = {});
+
+void rsa_encrypt(
+    int64_t mod,
+    int64_t recv_shared_key,
+    libcrypt::ByteSource& message,
+    libcrypt::ByteSink& encrypted,
+    const libcrypt::cipher_options& options = {});
+
+void rsa_decrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options = {});
+
+void rsa_decrypt(
+    const libcrypt::rsa_private_key& recv_private_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options = {});
+
+// Packed variants: as many plaintext bytes as fit below the modulus share one block, blocks are stored at the
+// modulus bit width after a versioned header (see packed_format.hpp)
+
+void shamir_encrypt_packed(
+    int64_t mod,
+    int64_t recv_private_key,
+    int64_t send_private_key,
+    std::ifstream& message_file,
     std::fstream& encrypt_file);
 
-void elgamal_decrypt(int64_t mod, int64_t recv_private_key, std::fstream& encrypt_file, std::ofstream& decrypt_file);
+void shamir_decrypt_packed(
+    int64_t mod,
+    int64_t recv_shared_key,
+    int64_t send_shared_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file);
 
-void vernam_encrypt(std::fstream& vernam_key_file, std::ifstream& message_file, std::fstream& encrypt_file);
+void elgamal_encrypt_packed(
+    libcrypt::dh_system_params sys_params,
+    int64_t session_key,
+    int64_t recv_shared_key,
+    std::ifstream& message_file,
+    std::fstream& encrypt_file);
 
-void vernam_decrypt(std::fstream& vernam_key_file, std::fstream& encrypt_file, std::ofstream& decrypt_file);
+void elgamal_decrypt_packed(
+    int64_t mod,
+    int64_t recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file);
 
-void rsa_encrypt(int64_t mod, int64_t recv_shared_key, std::ifstream& message_file, std::fstream& encrypt_file);
+void rsa_encrypt_packed(int64_t mod, int64_t recv_shared_key, std::ifstream& message_file, std::fstream& encrypt_file);
 
-void rsa_decrypt(int64_t mod, int64_t recv_private_key, std::fstream& encrypt_file, std::ofstream& decrypt_file);
+void rsa_decrypt_packed(
+    const libcrypt::rsa_private_key& recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file);
 
 }  // namespace libcrypt
\ No newline at end of file
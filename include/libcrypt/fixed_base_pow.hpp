@@ -0,0 +1,24 @@
+#pragma once
+#include <libcrypt/montgomery.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace libcrypt {
+
+// Powers of one long-lived base: table[window][digit] = base^(digit * 2^(window * window_bits)),
+// so pow() costs one multiplication per non-zero exponent window and no squarings
+class FixedBasePow
+{
+    libcrypt::MontgomeryContext ctx;
+    int exp_bits;
+    int window_bits;
+    std::vector<uint64_t> table;
+
+   public:
+    FixedBasePow(int64_t base, const libcrypt::MontgomeryContext& ctx, int exp_bits, int window_bits = 4);
+
+    // base^exp in [0, mod) for 0 <= exp < 2^exp_bits
+    int64_t pow(int64_t exp) const;
+};
+
+}  // namespace libcrypt
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace libcrypt {
+
+enum class open_mode {
+    read,
+    write
+};
+
+// Owns a file descriptor opened by path; descriptors passed in by callers are never closed
+class FileDescriptor
+{
+    int fd = -1;
+
+   public:
+    FileDescriptor(const std::filesystem::path& path, libcrypt::open_mode mode);
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    ~FileDescriptor();
+
+    int get() const
+    {
+        return fd;
+    }
+};
+
+// Uniquely named file next to a target path, removed again unless it replaces the target
+class TempFile
+{
+    std::filesystem::path path;
+    int fd = -1;
+    bool replaced = false;
+
+   public:
+    explicit TempFile(const std::filesystem::path& target);
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    ~TempFile();
+
+    int get() const
+    {
+        return fd;
+    }
+
+    // renames the file over target, keeping the permissions target had
+    void replace(const std::filesystem::path& target);
+};
+
+// true when both descriptors refer to the same file
+bool is_same_file(int first_fd, int second_fd);
+
+// Shared mapping of a whole regular file, advised for sequential access
+class MappedFile
+{
+    char* mapping = nullptr;
+    std::size_t mapping_size = 0;
+
+    void map(int fd, int protection);
+
+   public:
+    // read-only mapping of the current file contents
+    explicit MappedFile(int fd);
+
+    // truncates or extends the file to size bytes and maps it writable
+    MappedFile(int fd, std::size_t size);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    std::size_t size() const
+    {
+        return mapping_size;
+    }
+
+    std::span<const char> view() const
+    {
+        return {mapping, mapping_size};
+    }
+
+    std::span<char> data()
+    {
+        return {mapping, mapping_size};
+    }
+};
+
+}  // namespace libcrypt
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+namespace libcrypt {
+
+__extension__ using int128_t = __int128;
+__extension__ using uint128_t = unsigned __int128;
+
+class MontgomeryContext
+{
+    uint64_t modulus;
+    uint64_t neg_mod_inv;  // -modulus^(-1) mod 2^64
+    uint64_t r_mod;        // 2^64 mod modulus
+    uint64_t r2_mod;       // 2^128 mod modulus
+
+   public:
+    explicit MontgomeryContext(int64_t mod);
+
+    int64_t get_mod() const
+    {
+        return static_cast<int64_t>(modulus);
+    }
+
+    uint64_t one() const
+    {
+        return r_mod;
+    }
+
+    uint64_t reduce(uint128_t value) const
+    {
+        const uint64_t m = static_cast<uint64_t>(value) * neg_mod_inv;
+        const auto result = static_cast<uint64_t>((value + static_cast<uint128_t>(m) * modulus) >> 64);
+        return (result >= modulus) ? result - modulus : result;
+    }
+
+    uint64_t mul(uint64_t first, uint64_t second) const
+    {
+        return reduce(static_cast<uint128_t>(first) * second);
+    }
+
+    uint64_t to_form(int64_t value) const;
+
+    int64_t from_form(uint64_t value) const
+    {
+        return static_cast<int64_t>(reduce(value));
+    }
+};
+
+}  // namespace libcrypt
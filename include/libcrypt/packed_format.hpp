@@ -0,0 +1,102 @@
+#pragma once
+#include <libcrypt/block_io.hpp>
+#include <libcrypt/montgomery.hpp>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <span>
+
+namespace libcrypt {
+
+constexpr uint32_t packed_magic = 0x4b50434c;  // "LCPK" when stored little-endian
+constexpr uint8_t packed_version = 1;
+
+enum class packed_algorithm : uint8_t
+{
+    shamir = 1,
+    elgamal = 2,
+    rsa = 3
+};
+
+// Ciphertext layout: magic, version, algorithm, mod_bits, bytes_per_block, message_size, ciphertext_first,
+// then one mod_bits wide value per block of bytes_per_block plaintext bytes, packed LSB first
+struct packed_header
+{
+    libcrypt::packed_algorithm algorithm;
+    uint8_t mod_bits;
+    uint8_t bytes_per_block;
+    uint64_t message_size;
+    int64_t ciphertext_first;  // ElGamal only
+};
+
+// number of whole plaintext bytes whose value is always below mod
+uint8_t packed_bytes_per_block(int64_t mod);
+
+// measures the rest of message without consuming it
+libcrypt::packed_header make_packed_header(
+    libcrypt::packed_algorithm algorithm,
+    int64_t mod,
+    std::istream& message,
+    int64_t ciphertext_first = 0);
+
+void write_packed_header(std::ostream& output, const libcrypt::packed_header& header);
+
+// throws if the stream isn't a packed ciphertext of this algorithm produced for a modulus of this width
+libcrypt::packed_header read_packed_header(std::istream& input, libcrypt::packed_algorithm algorithm, int64_t mod);
+
+class BitWriter
+{
+    libcrypt::BlockWriter<char> writer;
+    libcrypt::uint128_t buffer = 0;
+    int buffered_bits = 0;
+
+   public:
+    explicit BitWriter(std::ostream& output) : writer(output) {}
+
+    BitWriter(const BitWriter&) = delete;
+    BitWriter& operator=(const BitWriter&) = delete;
+
+    ~BitWriter()
+    {
+        flush();
+    }
+
+    // bits <= 64
+    void write(uint64_t value, int bits);
+
+    // pads the last byte with zero bits
+    void flush();
+};
+
+class BitReader
+{
+    libcrypt::BlockReader<char> reader;
+    std::span<const char> block;
+    std::size_t position = 0;
+    libcrypt::uint128_t buffer = 0;
+    int buffered_bits = 0;
+
+   public:
+    explicit BitReader(std::istream& input) : reader(input) {}
+
+    // bits <= 64, throws if the stream ends first
+    uint64_t read(int bits);
+};
+
+using packed_block_transform = std::function<uint64_t(uint64_t)>;
+
+// message bytes are grouped big-endian into blocks, the last block is zero padded
+void pack_stream(
+    std::istream& message,
+    std::ostream& packed,
+    const libcrypt::packed_header& header,
+    const libcrypt::packed_block_transform& transform);
+
+void unpack_stream(
+    std::istream& packed,
+    std::ostream& message,
+    const libcrypt::packed_header& header,
+    const libcrypt::packed_block_transform& transform);
+
+}  // namespace libcrypt
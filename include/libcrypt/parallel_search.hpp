@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <random>
+
+namespace libcrypt {
+
+// one randomized search step: returns a found value (>= 0) or -1 to try again
+using search_attempt = std::function<int64_t(std::mt19937& mt)>;
+
+unsigned hardware_threads_num();
+
+// Repeats attempt on threads_num workers, each drawing from its own independently seeded engine.
+// The first worker to succeed cancels the others; with threads_num <= 1 the search runs on the caller's thread.
+int64_t parallel_search(const libcrypt::search_attempt& attempt, unsigned threads_num);
+
+}  // namespace libcrypt
@@ -0,0 +1,52 @@
+#pragma once
+#include <libcrypt/montgomery.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace libcrypt {
+
+constexpr int rsa_batch_exp_bits = 20;
+constexpr std::size_t rsa_batch_min_size = 4;
+
+// Checks many (hash, signature) pairs under one RSA public key. Identical pairs are checked once, which is most of
+// the work saved for signatures of hex digests.
+// screen() goes further and combines the distinct pairs into prod(s_i^r_i)^e == prod(h_i^r_i) with random odd r_i
+// below 2^rsa_batch_exp_bits, so one check covers the whole batch. A failing batch is split in halves until the bad
+// pairs are found, and batches of at most rsa_batch_min_size pairs are checked one by one. Screening is
+// probabilistic: a bad pair passes a combined check with probability about 2^-rsa_batch_exp_bits, and it can't tell
+// s from s times an element of small order such as n - s. Use it only where that's acceptable.
+class RsaBatchVerifier
+{
+    libcrypt::MontgomeryContext ctx;
+    int64_t shared_key;
+    std::mt19937_64 mt;
+
+    bool check_one(int64_t hash, int64_t signature) const;
+
+    bool check_combined(std::span<const int64_t> hashes, std::span<const int64_t> signatures);
+
+    void screen_batch(
+        std::span<const int64_t> hashes,
+        std::span<const int64_t> signatures,
+        std::span<const std::size_t> indices,
+        std::vector<bool>& valid);
+
+    std::vector<bool> check_distinct(
+        std::span<const int64_t> hashes,
+        std::span<const int64_t> signatures,
+        bool combine);
+
+   public:
+    RsaBatchVerifier(int64_t mod, int64_t shared_key);
+
+    // valid[i] tells whether signatures[i]^e == hashes[i] mod n
+    std::vector<bool> verify(std::span<const int64_t> hashes, std::span<const int64_t> signatures);
+
+    // like verify(), but a bad pair may be reported valid, see above
+    std::vector<bool> screen(std::span<const int64_t> hashes, std::span<const int64_t> signatures);
+};
+
+}  // namespace libcrypt
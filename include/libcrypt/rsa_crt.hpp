@@ -0,0 +1,37 @@
+#pragma once
+#include <libcrypt/montgomery.hpp>
+#include <cstdint>
+
+namespace libcrypt {
+
+// keeps the factors of the modulus so private exponentiations can work modulo p and q separately
+struct rsa_private_key
+{
+    int64_t p;
+    int64_t q;
+    int64_t dp;     // d mod (p - 1)
+    int64_t dq;     // d mod (q - 1)
+    int64_t q_inv;  // q^(-1) mod p
+};
+
+libcrypt::rsa_private_key make_rsa_private_key(int64_t p, int64_t q, int64_t private_exp);
+
+class RsaCrt
+{
+    libcrypt::rsa_private_key key;
+    libcrypt::MontgomeryContext p_ctx;
+    libcrypt::MontgomeryContext q_ctx;
+
+   public:
+    explicit RsaCrt(const libcrypt::rsa_private_key& key);
+
+    int64_t get_mod() const
+    {
+        return key.p * key.q;
+    }
+
+    // value^d mod pq with Garner's recombination, same sign convention as pow_mod
+    int64_t pow(int64_t value) const;
+};
+
+}  // namespace libcrypt
@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace libcrypt {
+
+enum class sha256_backend {
+    scalar,
+    sha_ni
+};
+
+bool is_sha256_backend_supported(libcrypt::sha256_backend backend);
+
+libcrypt::sha256_backend best_sha256_backend();
+
+class Sha256
+{
+   public:
+    static constexpr std::size_t block_size = 64;
+    static constexpr std::size_t digest_size = 32;
+
+    using compress_func = void (*)(uint32_t* state, const unsigned char* blocks, std::size_t blocks_num);
+
+   private:
+    std::array<uint32_t, 8> state;
+    std::array<unsigned char, block_size> pending{};
+    std::size_t pending_size = 0;
+    uint64_t total_size = 0;
+    compress_func compress;
+
+   public:
+    explicit Sha256(libcrypt::sha256_backend backend = libcrypt::best_sha256_backend());
+
+    void update(std::span<const char> data);
+
+    std::array<unsigned char, digest_size> finish();
+
+    std::string finish_hex();
+};
+
+}  // namespace libcrypt
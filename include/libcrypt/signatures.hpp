@@ -1,13 +1,25 @@
 #pragma once
 #include <libcrypt/utils.hpp>
+#include <libcrypt/rsa_crt.hpp>
 #include <fstream>
+#include <filesystem>
+#include <span>
+#include <vector>
+#include <istream>
+#include <string>
+#include <cstdint>
 
 namespace libcrypt {
 
 std::string calc_file_hash(std::fstream& file);
 
+// hashes exactly data_size bytes starting at the current read position
+std::string calc_file_hash(std::istream& file, int64_t data_size);
+
 void rsa_file_signing(int64_t mod, int64_t send_private_key, std::fstream& file);
 
+void rsa_file_signing(const libcrypt::rsa_private_key& send_private_key, std::fstream& file);
+
 bool rsa_check_file_sign(int64_t mod, int64_t send_shared_key, std::fstream& file);
 
 void elgamal_file_signing(
@@ -32,4 +44,55 @@ bool gost_check_file_sign(
     int64_t send_shared_key,
     std::fstream& file);
 
+struct file_sign_result
+{
+    std::filesystem::path path;
+    bool ok = false;    // the file was signed, or its signature is valid
+    std::string error;  // set when the file couldn't be processed at all
+};
+
+// Batch variants: files are opened by path and hashed concurrently on threads_num workers, while the key tables
+// (RSA signatures of the 16 hex digits, fixed-base powers of g and y) are built once per call and shared.
+// Signing appends to every file like the single-file functions; ElGamal draws a fresh session key per file.
+// Results follow the order of paths.
+
+std::vector<libcrypt::file_sign_result> rsa_files_signing(
+    const libcrypt::rsa_private_key& send_private_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num = 1);
+
+std::vector<libcrypt::file_sign_result> rsa_check_files_sign(
+    int64_t mod,
+    int64_t send_shared_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num = 1);
+
+std::vector<libcrypt::file_sign_result> elgamal_files_signing(
+    libcrypt::dh_system_params sys_params,
+    int64_t recv_private_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num = 1);
+
+std::vector<libcrypt::file_sign_result> elgamal_check_files_sign(
+    libcrypt::dh_system_params sys_params,
+    int64_t recv_shared_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num = 1);
+
+std::vector<libcrypt::file_sign_result> gost_files_signing(
+    int64_t mod,
+    int64_t elliptic_exp,
+    int64_t elliptic_coef,
+    int64_t send_private_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num = 1);
+
+std::vector<libcrypt::file_sign_result> gost_check_files_sign(
+    int64_t mod,
+    int64_t elliptic_exp,
+    int64_t elliptic_coef,
+    int64_t send_shared_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num = 1);
+
 }  // namespace libcrypt
\ No newline at end of file
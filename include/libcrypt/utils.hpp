@@ -1,5 +1,8 @@
 #pragma once
+#include <libcrypt/montgomery.hpp>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace libcrypt {
@@ -10,17 +13,69 @@ struct dh_system_params
     int64_t mod;
 };
 
+// gcd == first * x + second * y
+struct gcd_result
+{
+    int64_t gcd;
+    int64_t x;
+    int64_t y;
+};
+
 int64_t mod(int64_t value, int64_t mod);
 
+// (first * second) % mod without intermediate overflow, same sign convention as operator%
+inline int64_t mulmod(int64_t first, int64_t second, int64_t mod)
+{
+    return static_cast<int64_t>((static_cast<libcrypt::int128_t>(first) * second) % mod);
+}
+
 bool is_prime(int64_t prime);
 
-int64_t pow_mod(int64_t base, int64_t exp, int64_t mod);
+// binary: plain square-and-multiply
+// sliding_window: fewer multiplications for long public exponents
+// constant_time: the sequence of operations depends only on the modulus width, for private exponents
+enum class pow_mode
+{
+    binary,
+    sliding_window,
+    constant_time
+};
+
+// even moduli have no Montgomery form: they're exponentiated in binary mode, and constant_time throws for them
+int64_t pow_mod(int64_t base, int64_t exp, int64_t mod, libcrypt::pow_mode mode = libcrypt::pow_mode::binary);
 
+int64_t pow_mod(
+    int64_t base,
+    int64_t exp,
+    const libcrypt::MontgomeryContext& ctx,
+    libcrypt::pow_mode mode = libcrypt::pow_mode::binary);
+
+constexpr size_t multi_pow_max_bases = 4;
+
+// product of bases[i]^exps[i] in [0, mod) with the squarings shared between all bases (Straus' method)
+int64_t multi_pow_mod(std::span<const int64_t> bases, std::span<const int64_t> exps, int64_t mod);
+
+int64_t multi_pow_mod(
+    std::span<const int64_t> bases,
+    std::span<const int64_t> exps,
+    const libcrypt::MontgomeryContext& ctx);
+
+libcrypt::gcd_result xgcd(int64_t first, int64_t second);
+
+// {gcd, coefficient of the greater value, coefficient of the lesser value}
 std::vector<int64_t> extended_gcd(int64_t first, int64_t second);
 
-int64_t gen_germain_prime();
+int64_t binary_gcd(int64_t first, int64_t second);
+
+// inverse of value in [0, mod) or -1 if value and mod are not coprime
+int64_t inverse_mod(int64_t value, int64_t mod);
+
+// Montgomery's trick: one inversion and 3(n - 1) multiplications, throws if any value is not invertible
+void batch_inverse_mod(std::span<const int64_t> values, std::span<int64_t> inverses, int64_t mod);
+
+int64_t gen_germain_prime(unsigned threads_num = 1);
 
-libcrypt::dh_system_params gen_dh_system();
+libcrypt::dh_system_params gen_dh_system(unsigned threads_num = 1);
 
 int64_t diffie_hellman(int64_t private_keyA, int64_t private_keyB);
 
@@ -0,0 +1,9 @@
+#pragma once
+#include <span>
+
+namespace libcrypt {
+
+// result[i] = first[i] ^ second[i]; picks AVX-512, AVX2 or a word-wise scalar loop once per process
+void xor_bytes(std::span<const char> first, std::span<const char> second, std::span<char> result);
+
+}  // namespace libcrypt
@@ -2,6 +2,7 @@
 #include <signatures/sign_example.hpp>
 #include <poker/poker_example.hpp>
 #include <blind_sign/blind_sign_example.hpp>
+#include <libcrypt/parallel_search.hpp>
 #include <cxxopts.hpp>
 #include <iostream>
 #include <exception>
@@ -25,6 +26,7 @@ int main(int argc, char** argv)
         ("gost", "gost sign call")
         ("players", "number of players", cxxopts::value<uint8_t>()->default_value("10"))
         ("answer", "answer for vote (0<=X<=2^32)", cxxopts::value<uint8_t>()->default_value("1"))
+        ("t,threads", "number of parameter search and cipher threads", cxxopts::value<unsigned>()->default_value(std::to_string(libcrypt::hardware_threads_num())))
         ("m,message", "message filename", cxxopts::value<std::string>()->default_value("examples/ciphers/message.txt"))
         ("e,encrypt", "encryption filename", cxxopts::value<std::string>()->default_value("examples/ciphers/encryption.txt"))
         ("d,decrypt", "decryption filename", cxxopts::value<std::string>()->default_value("examples/ciphers/decryption.txt"))
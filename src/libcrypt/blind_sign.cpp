@@ -5,18 +5,35 @@
 #include <string>
 #include <fstream>
 #include <exception>
-#include <vector>
 
 namespace libcrypt {
 
 void libcrypt::Server::send_blinded_sign(int64_t mod, int64_t server_private_key, std::fstream& secure_channel)
 {
+    const libcrypt::MontgomeryContext ctx(mod);
     int32_t blinded_hash_part = 0;
 
     while (secure_channel.read(reinterpret_cast<char*>(&blinded_hash_part), sizeof(blinded_hash_part)))
     {
-        const auto blinded_sign_part
-            = static_cast<int32_t>(libcrypt::pow_mod(blinded_hash_part, server_private_key, mod));
+        const auto blinded_sign_part = static_cast<int32_t>(
+            libcrypt::pow_mod(blinded_hash_part, server_private_key, ctx, libcrypt::pow_mode::constant_time));
+
+        secure_channel.seekg(static_cast<int64_t>(-1 * sizeof(blinded_hash_part)), std::ios::cur);
+
+        secure_channel.write(reinterpret_cast<const char*>(&blinded_sign_part), sizeof(blinded_sign_part));
+    }
+}
+
+void libcrypt::Server::send_blinded_sign(
+    const libcrypt::rsa_private_key& server_private_key,
+    std::fstream& secure_channel)
+{
+    const libcrypt::RsaCrt crt(server_private_key);
+    int32_t blinded_hash_part = 0;
+
+    while (secure_channel.read(reinterpret_cast<char*>(&blinded_hash_part), sizeof(blinded_hash_part)))
+    {
+        const auto blinded_sign_part = static_cast<int32_t>(crt.pow(blinded_hash_part));
 
         secure_channel.seekg(static_cast<int64_t>(-1 * sizeof(blinded_hash_part)), std::ios::cur);
 
@@ -31,6 +48,7 @@ bool libcrypt::Server::check_bulletin(int64_t mod, int64_t server_shared_key, st
     anonymous_channel.read(reinterpret_cast<char*>(&vote), sizeof(vote));
 
     const std::string vote_hash = picosha2::hash256_hex_string(std::to_string(vote));
+    const libcrypt::MontgomeryContext ctx(mod);
 
     for (const auto& hash_part : vote_hash)
     {
@@ -38,7 +56,8 @@ bool libcrypt::Server::check_bulletin(int64_t mod, int64_t server_shared_key, st
 
         anonymous_channel.read(reinterpret_cast<char*>(&signed_hash_part), sizeof(signed_hash_part));
 
-        if (hash_part != libcrypt::pow_mod(static_cast<int64_t>(signed_hash_part), server_shared_key, mod))
+        if (hash_part != libcrypt::pow_mod(
+                static_cast<int64_t>(signed_hash_part), server_shared_key, ctx, libcrypt::pow_mode::sliding_window))
         {
             return false;
         }
@@ -48,7 +67,6 @@ bool libcrypt::Server::check_bulletin(int64_t mod, int64_t server_shared_key, st
 
 void libcrypt::Elector::gen_blind_factor(int64_t mod)
 {
-    std::vector<int64_t> gcd_result;
     std::random_device rd;
     std::mt19937 mt(rd());
     std::uniform_int_distribution<int64_t> blind_factor_range(2, mod - 1);
@@ -56,15 +74,8 @@ void libcrypt::Elector::gen_blind_factor(int64_t mod)
     do
     {
         blind_factor = blind_factor_range(mt);
-        gcd_result = libcrypt::extended_gcd(blind_factor, mod);
-    } while (gcd_result.front() != 1);
-
-    inverse_blind_factor = gcd_result.back();
-
-    if (inverse_blind_factor < 0)
-    {
-        inverse_blind_factor += mod;
-    }
+        inverse_blind_factor = libcrypt::inverse_mod(blind_factor, mod);
+    } while (inverse_blind_factor < 0);
 }
 
 libcrypt::Elector::Elector(uint8_t answer)
@@ -96,10 +107,13 @@ void libcrypt::Elector::send_blinded_hash(int64_t mod, int64_t server_shared_key
 
     const std::string vote_hash{picosha2::hash256_hex_string(std::to_string(vote))};
 
+    const int64_t blind_factor_pow
+        = libcrypt::pow_mod(blind_factor, server_shared_key, mod, libcrypt::pow_mode::sliding_window);
+
     for (const auto& hash_part : vote_hash)
     {
-        const auto blinded_hash_part = static_cast<int32_t>(
-            libcrypt::mod(hash_part * libcrypt::pow_mod(blind_factor, server_shared_key, mod), mod));
+        const auto blinded_hash_part
+            = static_cast<int32_t>(libcrypt::mod(libcrypt::mulmod(hash_part, blind_factor_pow, mod), mod));
 
         secure_channel.write(reinterpret_cast<const char*>(&blinded_hash_part), sizeof(blinded_hash_part));
     }
@@ -113,7 +127,8 @@ void libcrypt::Elector::send_bulletin(int64_t mod, std::fstream& secure_channel,
 
     while (secure_channel.read(reinterpret_cast<char*>(&blinded_sign_part), sizeof(blinded_sign_part)))
     {
-        const auto sign_part = static_cast<int32_t>(libcrypt::mod(blinded_sign_part * inverse_blind_factor, mod));
+        const auto sign_part
+            = static_cast<int32_t>(libcrypt::mod(libcrypt::mulmod(blinded_sign_part, inverse_blind_factor, mod), mod));
 
         anonymous_channel.write(reinterpret_cast<const char*>(&sign_part), sizeof(sign_part));
     }
@@ -0,0 +1,672 @@
+#include <libcrypt/byte_stream.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#define LIBCRYPT_HAS_PREAD
+#include <unistd.h>
+#endif
+
+#if defined(LIBCRYPT_HAS_PREAD) && __has_include(<linux/io_uring.h>) && __has_include(<sys/syscall.h>)
+#define LIBCRYPT_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace libcrypt {
+
+std::size_t libcrypt::StreamSource::read(std::span<char> buffer)
+{
+    stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<std::size_t>(stream.gcount());
+}
+
+void libcrypt::StreamSink::write(std::span<const char> data)
+{
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+void libcrypt::StreamSink::flush()
+{
+    stream.flush();
+}
+
+struct uring_completion
+{
+    uint64_t user_data;
+    int32_t result;
+};
+
+#ifdef LIBCRYPT_HAS_IO_URING
+
+// Bare io_uring submission and completion rings, driven through raw syscalls
+class UringQueue
+{
+    int ring_fd = -1;
+    void* sq_ring = MAP_FAILED;
+    std::size_t sq_ring_size = 0;
+    void* cq_ring = MAP_FAILED;
+    std::size_t cq_ring_size = 0;
+    io_uring_sqe* sqes = nullptr;
+    std::size_t sqes_size = 0;
+
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned sq_mask = 0;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned cq_mask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    // pushed but not yet handed to the kernel
+    unsigned pending = 0;
+
+    void setup(unsigned entries)
+    {
+        io_uring_params params = {};
+
+        ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd < 0)
+        {
+            throw std::runtime_error{"io_uring isn't available"};
+        }
+
+        check_opcodes();
+
+        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap)
+        {
+            sq_ring_size = std::max(sq_ring_size, cq_ring_size);
+        }
+
+        sq_ring = ::mmap(
+            nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+        if (sq_ring == MAP_FAILED)
+        {
+            throw std::runtime_error{"can't map io_uring submission ring"};
+        }
+
+        if (!single_mmap)
+        {
+            cq_ring = ::mmap(
+                nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+            if (cq_ring == MAP_FAILED)
+            {
+                throw std::runtime_error{"can't map io_uring completion ring"};
+            }
+        }
+
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes_mapping
+            = ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+        if (sqes_mapping == MAP_FAILED)
+        {
+            throw std::runtime_error{"can't map io_uring submission entries"};
+        }
+        sqes = static_cast<io_uring_sqe*>(sqes_mapping);
+
+        char* const sq = static_cast<char*>(sq_ring);
+        char* const cq = static_cast<char*>(single_mmap ? sq_ring : cq_ring);
+
+        sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    // IORING_OP_READ and IORING_OP_WRITE came in Linux 5.6 together with the probe, so older kernels fail here too
+    void check_opcodes()
+    {
+        constexpr unsigned ops_num = 256;
+
+        // io_uring_probe ends in a flexible array of io_uring_probe_op, the kernel wants it zeroed
+        std::vector<io_uring_probe_op> storage(ops_num + sizeof(io_uring_probe) / sizeof(io_uring_probe_op));
+        auto* const probe = reinterpret_cast<io_uring_probe*>(storage.data());
+
+        if (::syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, ops_num) < 0)
+        {
+            throw std::runtime_error{"io_uring can't report supported operations"};
+        }
+
+        for (const unsigned opcode : {IORING_OP_READ, IORING_OP_WRITE})
+        {
+            if (opcode > probe->last_op || (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0)
+            {
+                throw std::runtime_error{"io_uring doesn't support plain reads and writes"};
+            }
+        }
+    }
+
+    void release()
+    {
+        if (sqes != nullptr)
+        {
+            ::munmap(sqes, sqes_size);
+        }
+        if (cq_ring != MAP_FAILED)
+        {
+            ::munmap(cq_ring, cq_ring_size);
+        }
+        if (sq_ring != MAP_FAILED)
+        {
+            ::munmap(sq_ring, sq_ring_size);
+        }
+        if (ring_fd >= 0)
+        {
+            ::close(ring_fd);
+        }
+    }
+
+    // returns how many of the pending entries the kernel consumed
+    unsigned enter(unsigned to_submit, unsigned min_complete, unsigned flags)
+    {
+        while (true)
+        {
+            const long submitted = ::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0);
+
+            if (submitted >= 0)
+            {
+                return static_cast<unsigned>(submitted);
+            }
+
+            if (errno != EINTR)
+            {
+                throw std::runtime_error{"io_uring_enter failed"};
+            }
+        }
+    }
+
+    void push(uint8_t opcode, int fd, const char* data, std::size_t size, int64_t offset, uint64_t user_data)
+    {
+        // the queue never holds more requests than it has entries, so the submission ring can't be full
+        const unsigned tail = *sq_tail;
+        const unsigned index = tail & sq_mask;
+
+        sqes[index] = {};
+        sqes[index].opcode = opcode;
+        sqes[index].fd = fd;
+        sqes[index].addr = reinterpret_cast<uint64_t>(data);
+        sqes[index].len = static_cast<uint32_t>(size);
+        sqes[index].off = static_cast<uint64_t>(offset);
+        sqes[index].user_data = user_data;
+        sq_array[index] = index;
+
+        std::atomic_ref<unsigned>(*sq_tail).store(tail + 1, std::memory_order_release);
+        pending++;
+    }
+
+   public:
+    explicit UringQueue(unsigned entries)
+    {
+        try
+        {
+            setup(entries);
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    UringQueue(const UringQueue&) = delete;
+    UringQueue& operator=(const UringQueue&) = delete;
+
+    ~UringQueue()
+    {
+        release();
+    }
+
+    void push_read(int fd, std::span<char> buffer, int64_t offset, uint64_t user_data)
+    {
+        push(IORING_OP_READ, fd, buffer.data(), buffer.size(), offset, user_data);
+    }
+
+    void push_write(int fd, std::span<const char> data, int64_t offset, uint64_t user_data)
+    {
+        push(IORING_OP_WRITE, fd, data.data(), data.size(), offset, user_data);
+    }
+
+    // hands every pushed request to the kernel in a single io_uring_enter
+    void submit()
+    {
+        while (pending != 0)
+        {
+            pending -= enter(pending, 0, 0);
+        }
+    }
+
+    // submits whatever is pending in the same io_uring_enter that waits for the next completion
+    libcrypt::uring_completion wait()
+    {
+        const unsigned head = *cq_head;
+
+        while (head == std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire))
+        {
+            pending -= enter(pending, 1, IORING_ENTER_GETEVENTS);
+        }
+
+        const io_uring_cqe& cqe = cqes[head & cq_mask];
+        const libcrypt::uring_completion completion{cqe.user_data, cqe.res};
+
+        std::atomic_ref<unsigned>(*cq_head).store(head + 1, std::memory_order_release);
+
+        return completion;
+    }
+};
+
+#else
+
+class UringQueue
+{
+   public:
+    explicit UringQueue(unsigned /*entries*/)
+    {
+        throw std::runtime_error{"io_uring isn't available"};
+    }
+
+    void push_read(int /*fd*/, std::span<char> /*buffer*/, int64_t /*offset*/, uint64_t /*user_data*/) {}
+
+    void push_write(int /*fd*/, std::span<const char> /*data*/, int64_t /*offset*/, uint64_t /*user_data*/) {}
+
+    void submit() {}
+
+    libcrypt::uring_completion wait()
+    {
+        return {};
+    }
+};
+
+#endif
+
+bool io_uring_supported()
+{
+    static const bool supported = [] {
+        try
+        {
+            const libcrypt::UringQueue queue(1);
+            return true;
+        }
+        catch (const std::runtime_error&)
+        {
+            return false;
+        }
+    }();
+
+    return supported;
+}
+
+#ifdef LIBCRYPT_HAS_PREAD
+
+static std::unique_ptr<libcrypt::UringQueue> try_make_queue(unsigned queue_depth)
+{
+    if (queue_depth == 0)
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        return std::make_unique<libcrypt::UringQueue>(queue_depth);
+    }
+    catch (const std::runtime_error&)
+    {
+        return nullptr;
+    }
+}
+
+static int64_t current_offset(int fd)
+{
+    const off_t offset = ::lseek(fd, 0, SEEK_CUR);
+
+    if (offset < 0)
+    {
+        throw std::runtime_error{"file backend requires a seekable descriptor"};
+    }
+
+    return offset;
+}
+
+// interrupted or would-block requests are simply queued again
+static bool is_transient(int32_t result)
+{
+    return result == -EINTR || result == -EAGAIN;
+}
+
+libcrypt::FileSource::FileSource(int fd, std::size_t buffer_size, unsigned queue_depth)
+    : fd(fd),
+      next_offset(libcrypt::current_offset(fd)),
+      queue(libcrypt::try_make_queue(queue_depth)),
+      slots(queue ? queue_depth : 0)
+{
+    for (std::size_t i = 0; i < slots.size(); i++)
+    {
+        slots[i].buffer.resize(std::max<std::size_t>(buffer_size, 1));
+        submit(i);
+    }
+
+    if (queue)
+    {
+        queue->submit();
+    }
+}
+
+libcrypt::FileSource::~FileSource()
+{
+    // the kernel still owns buffers of in-flight reads
+    while (std::ranges::any_of(slots, [](const slot& s) { return s.in_flight; }))
+    {
+        try
+        {
+            complete_one();
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+}
+
+void libcrypt::FileSource::submit(std::size_t index)
+{
+    slot& s = slots[index];
+
+    s.filled = 0;
+    s.consumed = 0;
+    s.offset = next_offset;
+    s.in_flight = true;
+    next_offset += static_cast<int64_t>(s.buffer.size());
+
+    queue->push_read(fd, s.buffer, s.offset, index);
+}
+
+void libcrypt::FileSource::complete_one()
+{
+    const libcrypt::uring_completion completion = queue->wait();
+    slot& s = slots[completion.user_data];
+
+    if (completion.result < 0 && !libcrypt::is_transient(completion.result))
+    {
+        s.in_flight = false;
+        throw std::runtime_error{"can't read file"};
+    }
+
+    if (completion.result == 0)
+    {
+        s.in_flight = false;
+        return;
+    }
+
+    s.filled += static_cast<std::size_t>(std::max(completion.result, 0));
+
+    // a short read isn't necessarily the end of the file, ask for the rest
+    if (s.filled < s.buffer.size())
+    {
+        queue->push_read(
+            fd,
+            std::span<char>{s.buffer}.subspan(s.filled),
+            s.offset + static_cast<int64_t>(s.filled),
+            completion.user_data);
+        return;
+    }
+
+    s.in_flight = false;
+}
+
+std::size_t libcrypt::FileSource::read(std::span<char> buffer)
+{
+    if (!queue)
+    {
+        while (true)
+        {
+            const ssize_t bytes_read = ::pread(fd, buffer.data(), buffer.size(), next_offset);
+
+            if (bytes_read >= 0)
+            {
+                next_offset += bytes_read;
+                return static_cast<std::size_t>(bytes_read);
+            }
+
+            if (errno != EINTR)
+            {
+                throw std::runtime_error{"can't read file"};
+            }
+        }
+    }
+
+    std::size_t copied = 0;
+
+    while (copied < buffer.size() && !end)
+    {
+        slot& s = slots[current];
+
+        while (s.in_flight)
+        {
+            complete_one();
+        }
+
+        const std::size_t count = std::min(buffer.size() - copied, s.filled - s.consumed);
+        std::copy_n(
+            s.buffer.begin() + static_cast<std::ptrdiff_t>(s.consumed),
+            count,
+            buffer.begin() + static_cast<std::ptrdiff_t>(copied));
+        s.consumed += count;
+        copied += count;
+
+        if (s.consumed == s.filled)
+        {
+            if (s.filled < s.buffer.size())
+            {
+                end = true;
+                break;
+            }
+
+            submit(current);
+            current = (current + 1) % slots.size();
+        }
+    }
+
+    queue->submit();
+
+    return copied;
+}
+
+libcrypt::FileSink::FileSink(int fd, std::size_t buffer_size, unsigned queue_depth)
+    : fd(fd),
+      next_offset(libcrypt::current_offset(fd)),
+      queue(libcrypt::try_make_queue(queue_depth)),
+      slots(queue ? queue_depth : 0)
+{
+    for (auto& s : slots)
+    {
+        s.buffer.resize(std::max<std::size_t>(buffer_size, 1));
+    }
+}
+
+libcrypt::FileSink::~FileSink()
+{
+    try
+    {
+        flush();
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    while (std::ranges::any_of(slots, [](const slot& s) { return s.in_flight; }))
+    {
+        try
+        {
+            complete_one();
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+}
+
+void libcrypt::FileSink::submit(std::size_t index)
+{
+    slot& s = slots[index];
+
+    s.written = 0;
+    s.offset = next_offset;
+    s.in_flight = true;
+    next_offset += static_cast<int64_t>(s.filled);
+
+    queue->push_write(fd, std::span<const char>{s.buffer.data(), s.filled}, s.offset, index);
+}
+
+void libcrypt::FileSink::complete_one()
+{
+    const libcrypt::uring_completion completion = queue->wait();
+    slot& s = slots[completion.user_data];
+
+    if ((completion.result < 0 && !libcrypt::is_transient(completion.result)) || completion.result == 0)
+    {
+        s.in_flight = false;
+        s.filled = 0;
+        throw std::runtime_error{"can't write file"};
+    }
+
+    s.written += static_cast<std::size_t>(std::max(completion.result, 0));
+
+    if (s.written < s.filled)
+    {
+        queue->push_write(
+            fd,
+            std::span<const char>{s.buffer.data(), s.filled}.subspan(s.written),
+            s.offset + static_cast<int64_t>(s.written),
+            completion.user_data);
+        return;
+    }
+
+    s.in_flight = false;
+    s.filled = 0;
+}
+
+void libcrypt::FileSink::wait_for(std::size_t index)
+{
+    while (slots[index].in_flight)
+    {
+        complete_one();
+    }
+}
+
+void libcrypt::FileSink::write(std::span<const char> data)
+{
+    if (!queue)
+    {
+        while (!data.empty())
+        {
+            const ssize_t written = ::pwrite(fd, data.data(), data.size(), next_offset);
+
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (written <= 0)
+            {
+                throw std::runtime_error{"can't write file"};
+            }
+
+            next_offset += written;
+            data = data.subspan(static_cast<std::size_t>(written));
+        }
+        return;
+    }
+
+    while (!data.empty())
+    {
+        wait_for(current);
+
+        slot& s = slots[current];
+        const std::size_t count = std::min(data.size(), s.buffer.size() - s.filled);
+
+        std::copy_n(data.begin(), count, s.buffer.begin() + static_cast<std::ptrdiff_t>(s.filled));
+        s.filled += count;
+        data = data.subspan(count);
+
+        if (s.filled == s.buffer.size())
+        {
+            submit(current);
+            current = (current + 1) % slots.size();
+        }
+    }
+
+    queue->submit();
+}
+
+void libcrypt::FileSink::flush()
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    if (!slots[current].in_flight && slots[current].filled > 0)
+    {
+        submit(current);
+        current = (current + 1) % slots.size();
+    }
+
+    for (std::size_t i = 0; i < slots.size(); i++)
+    {
+        wait_for(i);
+    }
+}
+
+#else
+
+libcrypt::FileSource::FileSource(int /*fd*/, std::size_t /*buffer_size*/, unsigned /*queue_depth*/)
+{
+    throw std::runtime_error{"file backend isn't supported on this platform"};
+}
+
+libcrypt::FileSource::~FileSource() = default;
+
+void libcrypt::FileSource::submit(std::size_t /*index*/) {}
+
+void libcrypt::FileSource::complete_one() {}
+
+std::size_t libcrypt::FileSource::read(std::span<char> /*buffer*/)
+{
+    throw std::runtime_error{"file backend isn't supported on this platform"};
+}
+
+libcrypt::FileSink::FileSink(int /*fd*/, std::size_t /*buffer_size*/, unsigned /*queue_depth*/)
+{
+    throw std::runtime_error{"file backend isn't supported on this platform"};
+}
+
+libcrypt::FileSink::~FileSink() = default;
+
+void libcrypt::FileSink::submit(std::size_t /*index*/) {}
+
+void libcrypt::FileSink::complete_one() {}
+
+void libcrypt::FileSink::wait_for(std::size_t /*index*/) {}
+
+void libcrypt::FileSink::write(std::span<const char> /*data*/)
+{
+    throw std::runtime_error{"file backend isn't supported on this platform"};
+}
+
+void libcrypt::FileSink::flush() {}
+
+#endif
+
+}  // namespace libcrypt
@@ -0,0 +1,37 @@
+#include <libcrypt/byte_table.hpp>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace libcrypt {
+
+libcrypt::ByteEncryptionTable::ByteEncryptionTable(std::function<int64_t(int64_t)> byte_transform)
+    : encrypt_byte(std::move(byte_transform))
+{
+}
+
+libcrypt::ByteDecryptionTable::ByteDecryptionTable(std::function<int64_t(int64_t)> word_transform)
+    : decrypt_word(std::move(word_transform))
+{
+    table.reserve(byte_values_num);
+}
+
+char libcrypt::ByteDecryptionTable::operator()(int32_t encrypted_part)
+{
+    if (const auto found = table.find(encrypted_part); found != table.end())
+    {
+        return found->second;
+    }
+
+    const auto message_part = static_cast<char>(decrypt_word(static_cast<int64_t>(encrypted_part)));
+
+    // a corrupted stream may contain more distinct words than a byte can encode
+    if (table.size() < byte_values_num)
+    {
+        table.emplace(encrypted_part, message_part);
+    }
+
+    return message_part;
+}
+
+}  // namespace libcrypt
@@ -1,27 +1,194 @@
 #include <libcrypt/utils.hpp>
 #include <libcrypt/ciphers.hpp>
+#include <libcrypt/byte_table.hpp>
+#include <libcrypt/xor_kernel.hpp>
+#include <libcrypt/mapped_file.hpp>
+#include <libcrypt/packed_format.hpp>
+#include <libcrypt/chunk_pipeline.hpp>
+#include <libcrypt/byte_stream.hpp>
 #include <fstream>
 #include <cstdint>
 #include <exception>
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <vector>
+#include <filesystem>
 
 namespace libcrypt {
 
+libcrypt::ElgamalSession::ElgamalSession(
+    libcrypt::dh_system_params sys_params,
+    int64_t session_key,
+    int64_t recv_shared_key)
+    : ctx(sys_params.mod),
+      ciphertext_first(libcrypt::pow_mod(sys_params.base, session_key, ctx, libcrypt::pow_mode::constant_time)),
+      mont_mask(ctx.to_form(libcrypt::pow_mod(recv_shared_key, session_key, ctx, libcrypt::pow_mode::constant_time))),
+      sender(true)
+{
+}
+
+libcrypt::ElgamalSession::ElgamalSession(int64_t mod, int64_t recv_private_key, int64_t ciphertext_first)
+    : ctx(mod),
+      ciphertext_first(ciphertext_first),
+      mont_mask(ctx.to_form(
+          libcrypt::pow_mod(ciphertext_first, mod - 1 - recv_private_key, ctx, libcrypt::pow_mode::constant_time))),
+      sender(false)
+{
+}
+
+void libcrypt::ElgamalSession::encrypt(std::span<const char> message, std::span<int32_t> encrypted) const
+{
+    require_role(true);
+
+    if (encrypted.size() < message.size())
+    {
+        throw std::runtime_error{"ElGamal output span is shorter than the message"};
+    }
+
+    for (std::size_t i = 0; i < message.size(); i++)
+    {
+        encrypted[i] = static_cast<int32_t>(mul_signed(static_cast<int64_t>(message[i]), mont_mask));
+    }
+}
+
+void libcrypt::ElgamalSession::decrypt(std::span<const int32_t> encrypted, std::span<char> message) const
+{
+    require_role(false);
+
+    if (message.size() < encrypted.size())
+    {
+        throw std::runtime_error{"ElGamal output span is shorter than the ciphertext"};
+    }
+
+    for (std::size_t i = 0; i < encrypted.size(); i++)
+    {
+        message[i] = static_cast<char>(mul_signed(static_cast<int64_t>(encrypted[i]), mont_mask));
+    }
+}
+
+template <typename In, typename Out>
+struct stream_chunk
+{
+    std::vector<In> input;
+    std::vector<Out> output;
+};
+
+// transform_block(worker, block, transformed) runs concurrently for different workers when options.threads_num > 1
+template <typename In, typename Out, typename BlockTransform>
+static void transform_stream(
+    libcrypt::ByteSource& input,
+    libcrypt::ByteSink& output,
+    const libcrypt::cipher_options& options,
+    BlockTransform transform_block)
+{
+    const std::size_t chunk_count = std::max<std::size_t>(options.chunk_size / sizeof(In), 1);
+
+    libcrypt::process_chunks_in_order<libcrypt::stream_chunk<In, Out>>(
+        options.threads_num,
+        options.overlap_io,
+        [&](libcrypt::stream_chunk<In, Out>& chunk) { return libcrypt::read_block(input, chunk.input, chunk_count); },
+        [&](libcrypt::stream_chunk<In, Out>& chunk, unsigned worker) {
+            chunk.output.resize(chunk.input.size());
+            transform_block(worker, std::span<const In>{chunk.input}, std::span<Out>{chunk.output});
+        },
+        [&](const libcrypt::stream_chunk<In, Out>& chunk) {
+            libcrypt::write_block(output, std::span<const Out>{chunk.output});
+        });
+
+    output.flush();
+}
+
+// byte tables fill lazily and aren't thread safe, so every worker looks up its own copy
+template <typename In, typename Out, typename Table>
+static void transform_stream_by_table(
+    libcrypt::ByteSource& input,
+    libcrypt::ByteSink& output,
+    const libcrypt::cipher_options& options,
+    const Table& table)
+{
+    std::vector<Table> worker_tables(std::max(options.threads_num, 1U), table);
+
+    libcrypt::transform_stream<In, Out>(
+        input, output, options, [&](unsigned worker, std::span<const In> block, std::span<Out> transformed) {
+            std::ranges::transform(block, transformed.begin(), std::ref(worker_tables[worker]));
+        });
+}
+
+struct vernam_chunk
+{
+    std::vector<char> input;
+    std::vector<char> vernam_key;
+    std::vector<char> output;
+};
+
+static void vernam_xor(
+    libcrypt::ByteSource& vernam_key,
+    libcrypt::ByteSource& input,
+    libcrypt::ByteSink& output,
+    const libcrypt::cipher_options& options)
+{
+    const std::size_t chunk_count = std::max<std::size_t>(options.chunk_size, 1);
+
+    libcrypt::process_chunks_in_order<libcrypt::vernam_chunk>(
+        options.threads_num,
+        options.overlap_io,
+        [&](libcrypt::vernam_chunk& chunk) {
+            if (!libcrypt::read_block(input, chunk.input, chunk_count))
+            {
+                return false;
+            }
+
+            libcrypt::read_block(vernam_key, chunk.vernam_key, chunk.input.size());
+
+            if (chunk.vernam_key.size() < chunk.input.size())
+            {
+                throw std::runtime_error{"Size of vernam key isn't enough to cover the entire message"};
+            }
+
+            return true;
+        },
+        [](libcrypt::vernam_chunk& chunk, unsigned) {
+            chunk.output.resize(chunk.input.size());
+            libcrypt::xor_bytes(chunk.input, chunk.vernam_key, chunk.output);
+        },
+        [&](const libcrypt::vernam_chunk& chunk) { output.write(chunk.output); });
+
+    output.flush();
+}
+
 void shamir_encrypt(
     int64_t mod,
     int64_t recv_private_key,
     int64_t send_private_key,
     std::ifstream& message_file,
-    std::fstream& encrypt_file)
+    std::fstream& encrypt_file,
+    const libcrypt::cipher_options& options)
 {
-    char message_part = 0;
+    libcrypt::StreamSource message(message_file);
+    libcrypt::StreamSink encrypted(encrypt_file);
 
-    while (message_file.read(reinterpret_cast<char*>(&message_part), sizeof(message_part)))
-    {
-        auto encrypted_part = static_cast<int32_t>(libcrypt::pow_mod(
-            libcrypt::pow_mod(static_cast<int64_t>(message_part), send_private_key, mod), recv_private_key, mod));
+    libcrypt::shamir_encrypt(mod, recv_private_key, send_private_key, message, encrypted, options);
+}
 
-        encrypt_file.write(reinterpret_cast<const char*>(&encrypted_part), sizeof(encrypted_part));
-    }
+void shamir_encrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    int64_t send_private_key,
+    libcrypt::ByteSource& message,
+    libcrypt::ByteSink& encrypted,
+    const libcrypt::cipher_options& options)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+    const libcrypt::ByteEncryptionTable encryption_table([&](int64_t message_part) {
+        return libcrypt::pow_mod(
+            libcrypt::pow_mod(message_part, send_private_key, ctx, libcrypt::pow_mode::constant_time),
+            recv_private_key,
+            ctx,
+            libcrypt::pow_mode::constant_time);
+    });
+
+    libcrypt::transform_stream_by_table<char, int32_t>(message, encrypted, options, encryption_table);
 }
 
 void shamir_decrypt(
@@ -29,15 +196,33 @@ void shamir_decrypt(
     int64_t recv_shared_key,
     int64_t send_shared_key,
     std::fstream& encrypt_file,
-    std::ofstream& decrypt_file)
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options)
 {
-    int32_t message_part = 0;
+    libcrypt::StreamSource encrypted(encrypt_file);
+    libcrypt::StreamSink decrypted(decrypt_file);
 
-    while (encrypt_file.read(reinterpret_cast<char*>(&message_part), sizeof(message_part)))
-    {
-        decrypt_file << static_cast<char>(
-            libcrypt::pow_mod(libcrypt::pow_mod(message_part, send_shared_key, mod), recv_shared_key, mod));
-    }
+    libcrypt::shamir_decrypt(mod, recv_shared_key, send_shared_key, encrypted, decrypted, options);
+}
+
+void shamir_decrypt(
+    int64_t mod,
+    int64_t recv_shared_key,
+    int64_t send_shared_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+    const libcrypt::ByteDecryptionTable decryption_table([&](int64_t encrypted_part) {
+        return libcrypt::pow_mod(
+            libcrypt::pow_mod(encrypted_part, send_shared_key, ctx, libcrypt::pow_mode::constant_time),
+            recv_shared_key,
+            ctx,
+            libcrypt::pow_mode::constant_time);
+    });
+
+    libcrypt::transform_stream_by_table<int32_t, char>(encrypted, decrypted, options, decryption_table);
 }
 
 void elgamal_encrypt(
@@ -45,96 +230,355 @@ void elgamal_encrypt(
     int64_t session_key,
     int64_t recv_shared_key,
     std::ifstream& message_file,
-    std::fstream& encrypt_file)
+    std::fstream& encrypt_file,
+    const libcrypt::cipher_options& options)
 {
-    char message_part = 0;
+    libcrypt::StreamSource message(message_file);
+    libcrypt::StreamSink encrypted(encrypt_file);
 
-    auto ciphertext_first = static_cast<int32_t>(libcrypt::pow_mod(sys_params.base, session_key, sys_params.mod));
-    encrypt_file.write(reinterpret_cast<const char*>(&ciphertext_first), sizeof(ciphertext_first));
+    libcrypt::elgamal_encrypt(sys_params, session_key, recv_shared_key, message, encrypted, options);
+}
 
-    while (message_file.read(reinterpret_cast<char*>(&message_part), sizeof(message_part)))
-    {
-        auto ciphertext_second = static_cast<int32_t>(
-            ((static_cast<int64_t>(message_part) % sys_params.mod)
-             * (libcrypt::pow_mod(recv_shared_key, session_key, sys_params.mod) % sys_params.mod))
-            % sys_params.mod);
+void elgamal_encrypt(
+    libcrypt::dh_system_params sys_params,
+    int64_t session_key,
+    int64_t recv_shared_key,
+    libcrypt::ByteSource& message,
+    libcrypt::ByteSink& encrypted,
+    const libcrypt::cipher_options& options)
+{
+    const libcrypt::ElgamalSession session(sys_params, session_key, recv_shared_key);
+    const libcrypt::ByteEncryptionTable encryption_table(
+        [&](int64_t message_part) { return session.encrypt(message_part); });
 
-        encrypt_file.write(reinterpret_cast<const char*>(&ciphertext_second), sizeof(ciphertext_second));
-    }
+    const auto ciphertext_first = static_cast<int32_t>(session.get_ciphertext_first());
+    libcrypt::write_block(encrypted, std::span<const int32_t>{&ciphertext_first, 1});
+
+    libcrypt::transform_stream_by_table<char, int32_t>(message, encrypted, options, encryption_table);
 }
 
-void elgamal_decrypt(int64_t mod, int64_t recv_private_key, std::fstream& encrypt_file, std::ofstream& decrypt_file)
+void elgamal_decrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options)
 {
-    int32_t ciphertext_first = 0;
-    int32_t ciphertext_second = 0;
+    libcrypt::StreamSource encrypted(encrypt_file);
+    libcrypt::StreamSink decrypted(decrypt_file);
 
-    encrypt_file.read(reinterpret_cast<char*>(&ciphertext_first), sizeof(ciphertext_first));
+    libcrypt::elgamal_decrypt(mod, recv_private_key, encrypted, decrypted, options);
+}
 
-    while (encrypt_file.read(reinterpret_cast<char*>(&ciphertext_second), sizeof(ciphertext_second)))
-    {
-        decrypt_file << static_cast<char>(
-            ((ciphertext_second % mod) * (libcrypt::pow_mod(ciphertext_first, mod - 1 - recv_private_key, mod) % mod))
-            % mod);
-    }
+void elgamal_decrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options)
+{
+    std::vector<int32_t> ciphertext_first;
+    libcrypt::read_block(encrypted, ciphertext_first, 1);
+
+    const libcrypt::ElgamalSession session(
+        mod, recv_private_key, ciphertext_first.empty() ? 0 : ciphertext_first.front());
+
+    libcrypt::transform_stream<int32_t, char>(
+        encrypted, decrypted, options, [&](unsigned, std::span<const int32_t> block, std::span<char> message) {
+            session.decrypt(block, message);
+        });
 }
 
-void vernam_encrypt(std::fstream& vernam_key_file, std::ifstream& message_file, std::fstream& encrypt_file)
+void vernam_encrypt(
+    std::fstream& vernam_key_file,
+    std::ifstream& message_file,
+    std::fstream& encrypt_file,
+    const libcrypt::cipher_options& options)
 {
-    char message_part = 0;
-    char vernam_key_part = 0;
+    libcrypt::StreamSource vernam_key(vernam_key_file);
+    libcrypt::StreamSource message(message_file);
+    libcrypt::StreamSink encrypted(encrypt_file);
 
-    while (message_file.read(reinterpret_cast<char*>(&message_part), sizeof(message_part)))
-    {
-        if (vernam_key_file.read(reinterpret_cast<char*>(&vernam_key_part), sizeof(vernam_key_part)))
-        {
-            char encrypted_message = static_cast<char>(message_part ^ vernam_key_part);
-            encrypt_file.write(reinterpret_cast<const char*>(&encrypted_message), sizeof(char));
-        }
-        else
-        {
-            throw std::runtime_error{"Size of vernam key isn't enough to cover the entire message"};
-        }
-    }
+    libcrypt::vernam_xor(vernam_key, message, encrypted, options);
+}
+
+void vernam_encrypt(
+    libcrypt::ByteSource& vernam_key,
+    libcrypt::ByteSource& message,
+    libcrypt::ByteSink& encrypted,
+    const libcrypt::cipher_options& options)
+{
+    libcrypt::vernam_xor(vernam_key, message, encrypted, options);
 }
 
-void vernam_decrypt(std::fstream& vernam_key_file, std::fstream& encrypt_file, std::ofstream& decrypt_file)
+void vernam_decrypt(
+    std::fstream& vernam_key_file,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options)
 {
-    char message_part = 0;
-    char vernam_key_part = 0;
+    libcrypt::StreamSource vernam_key(vernam_key_file);
+    libcrypt::StreamSource encrypted(encrypt_file);
+    libcrypt::StreamSink decrypted(decrypt_file);
 
-    while (encrypt_file.read(reinterpret_cast<char*>(&message_part), sizeof(message_part)))
-    {
-        if (vernam_key_file.read(reinterpret_cast<char*>(&vernam_key_part), sizeof(vernam_key_part)))
-        {
-            decrypt_file << static_cast<char>(message_part ^ vernam_key_part);
-        }
-        else
-        {
-            throw std::runtime_error{"Size of vernam key isn't enough to cover the entire message"};
-        }
-    }
+    libcrypt::vernam_xor(vernam_key, encrypted, decrypted, options);
+}
+
+void vernam_decrypt(
+    libcrypt::ByteSource& vernam_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options)
+{
+    libcrypt::vernam_xor(vernam_key, encrypted, decrypted, options);
 }
 
-void rsa_encrypt(int64_t mod, int64_t recv_shared_key, std::ifstream& message_file, std::fstream& encrypt_file)
+void vernam_encrypt_mapped(int vernam_key_fd, int message_fd, int encrypt_fd)
 {
-    char message_part = 0;
+    // resizing the output would destroy an input before it's read
+    if (libcrypt::is_same_file(encrypt_fd, vernam_key_fd) || libcrypt::is_same_file(encrypt_fd, message_fd))
+    {
+        throw std::runtime_error{"Output file of vernam cipher can't be one of its input files"};
+    }
 
-    while (message_file.read(reinterpret_cast<char*>(&message_part), sizeof(message_part)))
+    const libcrypt::MappedFile vernam_key(vernam_key_fd);
+    const libcrypt::MappedFile message(message_fd);
+
+    if (vernam_key.size() < message.size())
     {
-        auto encrypted_part
-            = static_cast<int32_t>(libcrypt::pow_mod(static_cast<int64_t>(message_part), recv_shared_key, mod));
-        encrypt_file.write(reinterpret_cast<const char*>(&encrypted_part), sizeof(encrypted_part));
+        throw std::runtime_error{"Size of vernam key isn't enough to cover the entire message"};
     }
+
+    libcrypt::MappedFile encrypted(encrypt_fd, message.size());
+
+    libcrypt::xor_bytes(message.view(), vernam_key.view(), encrypted.data());
 }
 
-void rsa_decrypt(int64_t mod, int64_t recv_private_key, std::fstream& encrypt_file, std::ofstream& decrypt_file)
+void vernam_encrypt_mapped(
+    const std::filesystem::path& vernam_key_path,
+    const std::filesystem::path& message_path,
+    const std::filesystem::path& encrypt_path)
 {
-    int32_t message_part = 0;
+    const libcrypt::FileDescriptor vernam_key_fd(vernam_key_path, libcrypt::open_mode::read);
+    const libcrypt::FileDescriptor message_fd(message_path, libcrypt::open_mode::read);
 
-    while (encrypt_file.read(reinterpret_cast<char*>(&message_part), sizeof(message_part)))
+    if (std::filesystem::exists(encrypt_path)
+        && (std::filesystem::equivalent(encrypt_path, vernam_key_path)
+            || std::filesystem::equivalent(encrypt_path, message_path)))
     {
-        decrypt_file << static_cast<char>(libcrypt::pow_mod(message_part, recv_private_key, mod));
+        throw std::runtime_error{"Output file of vernam cipher can't be one of its input files"};
     }
+
+    libcrypt::TempFile encrypted(encrypt_path);
+
+    libcrypt::vernam_encrypt_mapped(vernam_key_fd.get(), message_fd.get(), encrypted.get());
+    encrypted.replace(encrypt_path);
+}
+
+void vernam_decrypt_mapped(int vernam_key_fd, int encrypt_fd, int decrypt_fd)
+{
+    libcrypt::vernam_encrypt_mapped(vernam_key_fd, encrypt_fd, decrypt_fd);
+}
+
+void vernam_decrypt_mapped(
+    const std::filesystem::path& vernam_key_path,
+    const std::filesystem::path& encrypt_path,
+    const std::filesystem::path& decrypt_path)
+{
+    libcrypt::vernam_encrypt_mapped(vernam_key_path, encrypt_path, decrypt_path);
+}
+
+void rsa_encrypt(
+    int64_t mod,
+    int64_t recv_shared_key,
+    std::ifstream& message_file,
+    std::fstream& encrypt_file,
+    const libcrypt::cipher_options& options)
+{
+    libcrypt::StreamSource message(message_file);
+    libcrypt::StreamSink encrypted(encrypt_file);
+
+    libcrypt::rsa_encrypt(mod, recv_shared_key, message, encrypted, options);
+}
+
+void rsa_encrypt(
+    int64_t mod,
+    int64_t recv_shared_key,
+    libcrypt::ByteSource& message,
+    libcrypt::ByteSink& encrypted,
+    const libcrypt::cipher_options& options)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+    const libcrypt::ByteEncryptionTable encryption_table([&](int64_t message_part) {
+        return libcrypt::pow_mod(message_part, recv_shared_key, ctx, libcrypt::pow_mode::sliding_window);
+    });
+
+    libcrypt::transform_stream_by_table<char, int32_t>(message, encrypted, options, encryption_table);
+}
+
+void rsa_decrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options)
+{
+    libcrypt::StreamSource encrypted(encrypt_file);
+    libcrypt::StreamSink decrypted(decrypt_file);
+
+    libcrypt::rsa_decrypt(mod, recv_private_key, encrypted, decrypted, options);
+}
+
+void rsa_decrypt(
+    int64_t mod,
+    int64_t recv_private_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+    const libcrypt::ByteDecryptionTable decryption_table([&](int64_t encrypted_part) {
+        return libcrypt::pow_mod(encrypted_part, recv_private_key, ctx, libcrypt::pow_mode::constant_time);
+    });
+
+    libcrypt::transform_stream_by_table<int32_t, char>(encrypted, decrypted, options, decryption_table);
+}
+
+void rsa_decrypt(
+    const libcrypt::rsa_private_key& recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file,
+    const libcrypt::cipher_options& options)
+{
+    libcrypt::StreamSource encrypted(encrypt_file);
+    libcrypt::StreamSink decrypted(decrypt_file);
+
+    libcrypt::rsa_decrypt(recv_private_key, encrypted, decrypted, options);
+}
+
+void rsa_decrypt(
+    const libcrypt::rsa_private_key& recv_private_key,
+    libcrypt::ByteSource& encrypted,
+    libcrypt::ByteSink& decrypted,
+    const libcrypt::cipher_options& options)
+{
+    const libcrypt::RsaCrt crt(recv_private_key);
+    const libcrypt::ByteDecryptionTable decryption_table(
+        [&](int64_t encrypted_part) { return crt.pow(encrypted_part); });
+
+    libcrypt::transform_stream_by_table<int32_t, char>(encrypted, decrypted, options, decryption_table);
+}
+
+static void encrypt_packed(
+    libcrypt::packed_algorithm algorithm,
+    int64_t mod,
+    int64_t ciphertext_first,
+    std::istream& message_file,
+    std::ostream& encrypt_file,
+    const libcrypt::packed_block_transform& transform)
+{
+    const libcrypt::packed_header header
+        = libcrypt::make_packed_header(algorithm, mod, message_file, ciphertext_first);
+
+    libcrypt::write_packed_header(encrypt_file, header);
+    libcrypt::pack_stream(message_file, encrypt_file, header, transform);
+}
+
+void shamir_encrypt_packed(
+    int64_t mod,
+    int64_t recv_private_key,
+    int64_t send_private_key,
+    std::ifstream& message_file,
+    std::fstream& encrypt_file)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+
+    libcrypt::encrypt_packed(
+        libcrypt::packed_algorithm::shamir, mod, 0, message_file, encrypt_file, [&](uint64_t block) {
+            const int64_t sent_block = libcrypt::pow_mod(
+                static_cast<int64_t>(block), send_private_key, ctx, libcrypt::pow_mode::constant_time);
+
+            return static_cast<uint64_t>(
+                libcrypt::pow_mod(sent_block, recv_private_key, ctx, libcrypt::pow_mode::constant_time));
+        });
+}
+
+void shamir_decrypt_packed(
+    int64_t mod,
+    int64_t recv_shared_key,
+    int64_t send_shared_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+    const libcrypt::packed_header header
+        = libcrypt::read_packed_header(encrypt_file, libcrypt::packed_algorithm::shamir, mod);
+
+    libcrypt::unpack_stream(encrypt_file, decrypt_file, header, [&](uint64_t block) {
+        return static_cast<uint64_t>(libcrypt::pow_mod(
+            libcrypt::pow_mod(static_cast<int64_t>(block), send_shared_key, ctx, libcrypt::pow_mode::constant_time),
+            recv_shared_key,
+            ctx,
+            libcrypt::pow_mode::constant_time));
+    });
+}
+
+void elgamal_encrypt_packed(
+    libcrypt::dh_system_params sys_params,
+    int64_t session_key,
+    int64_t recv_shared_key,
+    std::ifstream& message_file,
+    std::fstream& encrypt_file)
+{
+    const libcrypt::ElgamalSession session(sys_params, session_key, recv_shared_key);
+
+    libcrypt::encrypt_packed(
+        libcrypt::packed_algorithm::elgamal,
+        sys_params.mod,
+        session.get_ciphertext_first(),
+        message_file,
+        encrypt_file,
+        [&](uint64_t block) { return static_cast<uint64_t>(session.encrypt(static_cast<int64_t>(block))); });
+}
+
+void elgamal_decrypt_packed(
+    int64_t mod,
+    int64_t recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file)
+{
+    const libcrypt::packed_header header
+        = libcrypt::read_packed_header(encrypt_file, libcrypt::packed_algorithm::elgamal, mod);
+    const libcrypt::ElgamalSession session(mod, recv_private_key, header.ciphertext_first);
+
+    libcrypt::unpack_stream(encrypt_file, decrypt_file, header, [&](uint64_t block) {
+        return static_cast<uint64_t>(session.decrypt(static_cast<int64_t>(block)));
+    });
+}
+
+void rsa_encrypt_packed(int64_t mod, int64_t recv_shared_key, std::ifstream& message_file, std::fstream& encrypt_file)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+
+    libcrypt::encrypt_packed(
+        libcrypt::packed_algorithm::rsa, mod, 0, message_file, encrypt_file, [&](uint64_t block) {
+            return static_cast<uint64_t>(libcrypt::pow_mod(
+                static_cast<int64_t>(block), recv_shared_key, ctx, libcrypt::pow_mode::sliding_window));
+        });
+}
+
+void rsa_decrypt_packed(
+    const libcrypt::rsa_private_key& recv_private_key,
+    std::fstream& encrypt_file,
+    std::ofstream& decrypt_file)
+{
+    const libcrypt::RsaCrt crt(recv_private_key);
+    const libcrypt::packed_header header
+        = libcrypt::read_packed_header(encrypt_file, libcrypt::packed_algorithm::rsa, crt.get_mod());
+
+    libcrypt::unpack_stream(encrypt_file, decrypt_file, header, [&](uint64_t block) {
+        return static_cast<uint64_t>(crt.pow(static_cast<int64_t>(block)));
+    });
 }
 
 }  // namespace libcrypt
@@ -0,0 +1,72 @@
+#include <libcrypt/fixed_base_pow.hpp>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace libcrypt {
+
+libcrypt::FixedBasePow::FixedBasePow(
+    int64_t base,
+    const libcrypt::MontgomeryContext& ctx,
+    int exp_bits,
+    int window_bits)
+    : ctx(ctx), exp_bits(exp_bits), window_bits(window_bits)
+{
+    if (exp_bits <= 0 || exp_bits > std::numeric_limits<int64_t>::digits)
+    {
+        throw std::runtime_error{"Exponent width must be in range 1<=X<=63"};
+    }
+
+    if (window_bits <= 0 || window_bits > 8)
+    {
+        throw std::runtime_error{"Window width must be in range 1<=X<=8"};
+    }
+
+    const int windows_num = (exp_bits + window_bits - 1) / window_bits;
+    const size_t digits_num = size_t{1} << window_bits;
+
+    table.resize(windows_num * digits_num);
+
+    uint64_t window_base = ctx.to_form(base);
+
+    for (int window = 0; window < windows_num; window++)
+    {
+        uint64_t* const digits = table.data() + window * digits_num;
+
+        digits[0] = ctx.one();
+        for (size_t digit = 1; digit < digits_num; digit++)
+        {
+            digits[digit] = ctx.mul(digits[digit - 1], window_base);
+        }
+
+        window_base = ctx.mul(digits[digits_num - 1], window_base);
+    }
+}
+
+int64_t libcrypt::FixedBasePow::pow(int64_t exp) const
+{
+    if (exp < 0 || (exp_bits < std::numeric_limits<int64_t>::digits && (exp >> exp_bits) != 0))
+    {
+        throw std::runtime_error{"Exponent is out of the precomputed range"};
+    }
+
+    const size_t digits_num = size_t{1} << window_bits;
+    const auto digit_mask = static_cast<uint64_t>(digits_num - 1);
+
+    uint64_t result = ctx.one();
+    auto rest = static_cast<uint64_t>(exp);
+
+    for (size_t window = 0; rest != 0; window++, rest >>= window_bits)
+    {
+        const uint64_t digit = rest & digit_mask;
+
+        if (digit)
+        {
+            result = ctx.mul(result, table[window * digits_num + digit]);
+        }
+    }
+
+    return ctx.from_form(result);
+}
+
+}  // namespace libcrypt
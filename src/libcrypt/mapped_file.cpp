@@ -0,0 +1,186 @@
+#include <libcrypt/mapped_file.hpp>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <filesystem>
+
+#if __has_include(<sys/mman.h>)
+#define LIBCRYPT_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace libcrypt {
+
+#ifdef LIBCRYPT_HAS_MMAP
+
+constexpr mode_t new_file_mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+
+libcrypt::FileDescriptor::FileDescriptor(const std::filesystem::path& path, libcrypt::open_mode mode)
+    : fd(::open(
+        path.c_str(),
+        (mode == libcrypt::open_mode::read ? O_RDONLY : O_RDWR | O_CREAT | O_TRUNC) | O_CLOEXEC,
+        libcrypt::new_file_mode))
+{
+    if (fd < 0)
+    {
+        throw std::runtime_error{"can't open \"" + path.string() + '"'};
+    }
+}
+
+libcrypt::FileDescriptor::~FileDescriptor()
+{
+    ::close(fd);
+}
+
+libcrypt::TempFile::TempFile(const std::filesystem::path& target)
+{
+    std::string name = target.string() + ".XXXXXX";
+
+    fd = ::mkostemp(name.data(), O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error{"can't create temporary file next to \"" + target.string() + '"'};
+    }
+
+    path = name;
+}
+
+libcrypt::TempFile::~TempFile()
+{
+    ::close(fd);
+
+    if (!replaced)
+    {
+        ::unlink(path.c_str());
+    }
+}
+
+void libcrypt::TempFile::replace(const std::filesystem::path& target)
+{
+    // mkstemp creates the file with 0600, a new output gets the same mode FileDescriptor would give it
+    struct stat target_stat = {};
+    const mode_t mode = (::stat(target.c_str(), &target_stat) == 0) ? (target_stat.st_mode & 07777)
+                                                                     : libcrypt::new_file_mode;
+
+    if (::fchmod(fd, mode) != 0 || ::rename(path.c_str(), target.c_str()) != 0)
+    {
+        throw std::runtime_error{"can't replace \"" + target.string() + '"'};
+    }
+
+    replaced = true;
+}
+
+bool is_same_file(int first_fd, int second_fd)
+{
+    struct stat first_stat = {};
+    struct stat second_stat = {};
+
+    if (::fstat(first_fd, &first_stat) != 0 || ::fstat(second_fd, &second_stat) != 0)
+    {
+        throw std::runtime_error{"can't get file status"};
+    }
+
+    return first_stat.st_dev == second_stat.st_dev && first_stat.st_ino == second_stat.st_ino;
+}
+
+void libcrypt::MappedFile::map(int fd, int protection)
+{
+    if (mapping_size == 0)
+    {
+        return;
+    }
+
+    void* address = ::mmap(nullptr, mapping_size, protection, MAP_SHARED, fd, 0);
+
+    if (address == MAP_FAILED)
+    {
+        throw std::runtime_error{"can't map file into memory"};
+    }
+
+    mapping = static_cast<char*>(address);
+    static_cast<void>(::madvise(address, mapping_size, MADV_SEQUENTIAL));
+}
+
+libcrypt::MappedFile::MappedFile(int fd)
+{
+    struct stat file_stat = {};
+
+    if (::fstat(fd, &file_stat) != 0)
+    {
+        throw std::runtime_error{"can't get size of mapped file"};
+    }
+
+    if (!S_ISREG(file_stat.st_mode))
+    {
+        throw std::runtime_error{"only regular files can be mapped"};
+    }
+
+    mapping_size = static_cast<std::size_t>(file_stat.st_size);
+    map(fd, PROT_READ);
+}
+
+libcrypt::MappedFile::MappedFile(int fd, std::size_t size) : mapping_size(size)
+{
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        throw std::runtime_error{"can't resize mapped file"};
+    }
+
+    map(fd, PROT_READ | PROT_WRITE);
+}
+
+libcrypt::MappedFile::~MappedFile()
+{
+    if (mapping != nullptr)
+    {
+        ::munmap(mapping, mapping_size);
+    }
+}
+
+#else
+
+libcrypt::FileDescriptor::FileDescriptor(const std::filesystem::path& /*path*/, libcrypt::open_mode /*mode*/)
+{
+    throw std::runtime_error{"memory mapped files aren't supported on this platform"};
+}
+
+libcrypt::FileDescriptor::~FileDescriptor() = default;
+
+libcrypt::TempFile::TempFile(const std::filesystem::path& /*target*/)
+{
+    throw std::runtime_error{"memory mapped files aren't supported on this platform"};
+}
+
+libcrypt::TempFile::~TempFile() = default;
+
+void libcrypt::TempFile::replace(const std::filesystem::path& /*target*/) {}
+
+bool is_same_file(int /*first_fd*/, int /*second_fd*/)
+{
+    throw std::runtime_error{"memory mapped files aren't supported on this platform"};
+}
+
+void libcrypt::MappedFile::map(int /*fd*/, int /*protection*/)
+{
+    throw std::runtime_error{"memory mapped files aren't supported on this platform"};
+}
+
+libcrypt::MappedFile::MappedFile(int fd)
+{
+    map(fd, 0);
+}
+
+libcrypt::MappedFile::MappedFile(int fd, std::size_t size) : mapping_size(size)
+{
+    map(fd, 0);
+}
+
+libcrypt::MappedFile::~MappedFile() = default;
+
+#endif
+
+}  // namespace libcrypt
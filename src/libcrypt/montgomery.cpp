@@ -0,0 +1,32 @@
+#include <libcrypt/montgomery.hpp>
+#include <libcrypt/utils.hpp>
+#include <cstdint>
+#include <stdexcept>
+
+namespace libcrypt {
+
+libcrypt::MontgomeryContext::MontgomeryContext(int64_t mod) : modulus(static_cast<uint64_t>(mod))
+{
+    if (mod <= 0 || (mod & 1) == 0)
+    {
+        throw std::runtime_error{"Montgomery form requires an odd positive modulus"};
+    }
+
+    // Newton's iteration doubles the number of correct low bits: 3 -> 6 -> ... -> 96
+    uint64_t mod_inv = modulus;
+    for (int i = 0; i < 5; i++)
+    {
+        mod_inv *= 2 - modulus * mod_inv;
+    }
+
+    neg_mod_inv = -mod_inv;
+    r_mod = -modulus % modulus;
+    r2_mod = static_cast<uint64_t>((static_cast<uint128_t>(r_mod) * r_mod) % modulus);
+}
+
+uint64_t libcrypt::MontgomeryContext::to_form(int64_t value) const
+{
+    return mul(static_cast<uint64_t>(libcrypt::mod(value, static_cast<int64_t>(modulus))), r2_mod);
+}
+
+}  // namespace libcrypt
@@ -0,0 +1,250 @@
+#include <libcrypt/packed_format.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace libcrypt {
+
+// header fields are stored little-endian whatever the host byte order is; enums map to their unsigned size too
+template <typename T>
+using field_bits = std::make_unsigned_t<T>;
+
+template <typename T>
+static void write_field(std::ostream& output, T value)
+{
+    auto bits = static_cast<libcrypt::field_bits<T>>(value);
+    std::array<char, sizeof(T)> bytes{};
+
+    for (auto& byte : bytes)
+    {
+        byte = static_cast<char>(bits & UCHAR_MAX);
+        bits >>= CHAR_BIT;
+    }
+
+    output.write(bytes.data(), bytes.size());
+}
+
+template <typename T>
+static T read_field(std::istream& input)
+{
+    std::array<char, sizeof(T)> bytes{};
+    if (!input.read(bytes.data(), bytes.size()))
+    {
+        throw std::runtime_error{"Packed ciphertext header is truncated"};
+    }
+
+    libcrypt::field_bits<T> bits = 0;
+    for (auto byte = bytes.rbegin(); byte != bytes.rend(); ++byte)
+    {
+        bits = static_cast<libcrypt::field_bits<T>>((bits << CHAR_BIT) | static_cast<unsigned char>(*byte));
+    }
+
+    return static_cast<T>(bits);
+}
+
+static uint64_t low_bits_mask(int bits)
+{
+    return (bits >= 64) ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+}
+
+uint8_t packed_bytes_per_block(int64_t mod)
+{
+    if (mod <= 1 << CHAR_BIT)
+    {
+        throw std::runtime_error{"Modulus is too small to hold a plaintext byte"};
+    }
+
+    return static_cast<uint8_t>((std::bit_width(static_cast<uint64_t>(mod)) - 1) / CHAR_BIT);
+}
+
+libcrypt::packed_header make_packed_header(
+    libcrypt::packed_algorithm algorithm,
+    int64_t mod,
+    std::istream& message,
+    int64_t ciphertext_first)
+{
+    const std::istream::pos_type start = message.tellg();
+    message.seekg(0, std::ios::end);
+    const std::istream::pos_type end = message.tellg();
+    message.seekg(start);
+
+    if (start == std::istream::pos_type(-1) || end == std::istream::pos_type(-1))
+    {
+        throw std::runtime_error{"Packed format requires a seekable message"};
+    }
+
+    return {
+        algorithm,
+        static_cast<uint8_t>(std::bit_width(static_cast<uint64_t>(mod))),
+        libcrypt::packed_bytes_per_block(mod),
+        static_cast<uint64_t>(end - start),
+        ciphertext_first};
+}
+
+void write_packed_header(std::ostream& output, const libcrypt::packed_header& header)
+{
+    libcrypt::write_field(output, libcrypt::packed_magic);
+    libcrypt::write_field(output, libcrypt::packed_version);
+    libcrypt::write_field(output, header.algorithm);
+    libcrypt::write_field(output, header.mod_bits);
+    libcrypt::write_field(output, header.bytes_per_block);
+    libcrypt::write_field(output, header.message_size);
+    libcrypt::write_field(output, header.ciphertext_first);
+}
+
+libcrypt::packed_header read_packed_header(std::istream& input, libcrypt::packed_algorithm algorithm, int64_t mod)
+{
+    if (libcrypt::read_field<uint32_t>(input) != libcrypt::packed_magic)
+    {
+        throw std::runtime_error{"Not a packed ciphertext"};
+    }
+
+    if (libcrypt::read_field<uint8_t>(input) != libcrypt::packed_version)
+    {
+        throw std::runtime_error{"Unsupported packed ciphertext version"};
+    }
+
+    libcrypt::packed_header header{};
+    header.algorithm = libcrypt::read_field<libcrypt::packed_algorithm>(input);
+    header.mod_bits = libcrypt::read_field<uint8_t>(input);
+    header.bytes_per_block = libcrypt::read_field<uint8_t>(input);
+    header.message_size = libcrypt::read_field<uint64_t>(input);
+    header.ciphertext_first = libcrypt::read_field<int64_t>(input);
+
+    if (header.algorithm != algorithm)
+    {
+        throw std::runtime_error{"Packed ciphertext was produced by another algorithm"};
+    }
+
+    if (header.mod_bits != std::bit_width(static_cast<uint64_t>(mod))
+        || header.bytes_per_block != libcrypt::packed_bytes_per_block(mod))
+    {
+        throw std::runtime_error{"Packed ciphertext was produced for another modulus"};
+    }
+
+    return header;
+}
+
+void libcrypt::BitWriter::write(uint64_t value, int bits)
+{
+    std::array<char, sizeof(buffer)> bytes{};
+    std::size_t bytes_num = 0;
+
+    buffer |= static_cast<libcrypt::uint128_t>(value & libcrypt::low_bits_mask(bits)) << buffered_bits;
+    buffered_bits += bits;
+
+    while (buffered_bits >= CHAR_BIT)
+    {
+        bytes[bytes_num++] = static_cast<char>(buffer & UCHAR_MAX);
+        buffer >>= CHAR_BIT;
+        buffered_bits -= CHAR_BIT;
+    }
+
+    writer.write(std::span<const char>{bytes.data(), bytes_num});
+}
+
+void libcrypt::BitWriter::flush()
+{
+    if (buffered_bits > 0)
+    {
+        const auto last = static_cast<char>(buffer & UCHAR_MAX);
+        writer.write(std::span<const char>{&last, 1});
+        buffer = 0;
+        buffered_bits = 0;
+    }
+
+    writer.flush();
+}
+
+uint64_t libcrypt::BitReader::read(int bits)
+{
+    while (buffered_bits < bits)
+    {
+        if (position == block.size())
+        {
+            block = reader.next();
+            position = 0;
+
+            if (block.empty())
+            {
+                throw std::runtime_error{"Packed ciphertext is truncated"};
+            }
+        }
+
+        buffer |= static_cast<libcrypt::uint128_t>(static_cast<unsigned char>(block[position++])) << buffered_bits;
+        buffered_bits += CHAR_BIT;
+    }
+
+    const uint64_t value = static_cast<uint64_t>(buffer) & libcrypt::low_bits_mask(bits);
+    buffer >>= bits;
+    buffered_bits -= bits;
+
+    return value;
+}
+
+void pack_stream(
+    std::istream& message,
+    std::ostream& packed,
+    const libcrypt::packed_header& header,
+    const libcrypt::packed_block_transform& transform)
+{
+    const std::size_t block_bytes = header.bytes_per_block;
+
+    // whole blocks per read, so only the very last block can be partial
+    libcrypt::BlockReader<char> reader(message, block_bytes * (libcrypt::default_block_size / block_bytes));
+    libcrypt::BitWriter writer(packed);
+
+    for (auto chunk = reader.next(); !chunk.empty(); chunk = reader.next())
+    {
+        for (std::size_t i = 0; i < chunk.size(); i += block_bytes)
+        {
+            uint64_t block = 0;
+
+            for (std::size_t j = 0; j < block_bytes; j++)
+            {
+                const auto byte = (i + j < chunk.size()) ? static_cast<unsigned char>(chunk[i + j]) : 0;
+                block = (block << CHAR_BIT) | byte;
+            }
+
+            writer.write(transform(block), header.mod_bits);
+        }
+    }
+}
+
+void unpack_stream(
+    std::istream& packed,
+    std::ostream& message,
+    const libcrypt::packed_header& header,
+    const libcrypt::packed_block_transform& transform)
+{
+    const std::size_t block_bytes = header.bytes_per_block;
+
+    libcrypt::BitReader reader(packed);
+    libcrypt::BlockWriter<char> writer(message);
+    std::array<char, sizeof(uint64_t)> bytes{};
+
+    for (uint64_t left = header.message_size; left > 0;)
+    {
+        const uint64_t block = transform(reader.read(header.mod_bits));
+
+        if ((block >> (block_bytes * CHAR_BIT)) != 0)
+        {
+            throw std::runtime_error{"Packed block doesn't decode to plaintext bytes"};
+        }
+
+        for (std::size_t j = 0; j < block_bytes; j++)
+        {
+            bytes[j] = static_cast<char>((block >> ((block_bytes - 1 - j) * CHAR_BIT)) & UCHAR_MAX);
+        }
+
+        const std::size_t bytes_num = std::min<uint64_t>(block_bytes, left);
+        writer.write(std::span<const char>{bytes.data(), bytes_num});
+        left -= bytes_num;
+    }
+}
+
+}  // namespace libcrypt
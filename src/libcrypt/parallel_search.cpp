@@ -0,0 +1,81 @@
+#include <libcrypt/parallel_search.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace libcrypt {
+
+unsigned hardware_threads_num()
+{
+    return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+int64_t parallel_search(const libcrypt::search_attempt& attempt, unsigned threads_num)
+{
+    std::random_device rd;
+
+    if (threads_num <= 1)
+    {
+        std::mt19937 mt(rd());
+        int64_t result = -1;
+
+        while (result < 0)
+        {
+            result = attempt(mt);
+        }
+
+        return result;
+    }
+
+    std::atomic<int64_t> result{-1};
+    std::stop_source stop;
+    std::exception_ptr worker_error;
+    std::mutex worker_error_mutex;
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(threads_num);
+
+        for (unsigned i = 0; i < threads_num; i++)
+        {
+            workers.emplace_back([&, seed = rd()] {
+                std::mt19937 mt(seed);
+
+                try
+                {
+                    while (!stop.stop_requested())
+                    {
+                        int64_t found = attempt(mt);
+                        int64_t not_found = -1;
+
+                        if (found >= 0 && result.compare_exchange_strong(not_found, found))
+                        {
+                            stop.request_stop();
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    const std::lock_guard lock(worker_error_mutex);
+                    worker_error = std::current_exception();
+                    stop.request_stop();
+                }
+            });
+        }
+    }
+
+    if (worker_error)
+    {
+        std::rethrow_exception(worker_error);
+    }
+
+    return result;
+}
+
+}  // namespace libcrypt
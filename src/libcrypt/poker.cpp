@@ -9,7 +9,6 @@ namespace libcrypt {
 
 libcrypt::Player::Player(int64_t mod)
 {
-    std::vector<int64_t> gcd_result;
     std::random_device rd;
     std::mt19937 mt(rd());
     std::uniform_int_distribution<int64_t> key_c_range(2, mod - 2);
@@ -17,15 +16,8 @@ libcrypt::Player::Player(int64_t mod)
     do
     {
         key_c = key_c_range(mt);
-        gcd_result = libcrypt::extended_gcd(key_c, mod - 1);
-    } while (gcd_result.front() != 1);
-
-    key_d = gcd_result.back();
-
-    if (key_d < 0)
-    {
-        key_d += mod - 1;
-    }
+        key_d = libcrypt::inverse_mod(key_c, mod - 1);
+    } while (key_d < 0);
 }
 
 void libcrypt::Player::shuffle(std::deque<int64_t>& card_deck)
@@ -37,9 +29,11 @@ void libcrypt::Player::shuffle(std::deque<int64_t>& card_deck)
 
 void libcrypt::Player::deck_encryption(std::deque<int64_t>& card_deck, int64_t mod) const
 {
+    const libcrypt::MontgomeryContext ctx(mod);
+
     for (auto& card : card_deck)
     {
-        card = libcrypt::pow_mod(card, key_c, mod);
+        card = libcrypt::pow_mod(card, key_c, ctx, libcrypt::pow_mode::constant_time);
     }
 
     Player::shuffle(card_deck);
@@ -47,9 +41,11 @@ void libcrypt::Player::deck_encryption(std::deque<int64_t>& card_deck, int64_t m
 
 void libcrypt::Player::deck_decryption(std::deque<int64_t>& card_deck, int64_t mod) const
 {
+    const libcrypt::MontgomeryContext ctx(mod);
+
     for (auto& card : card_deck)
     {
-        card = libcrypt::pow_mod(card, key_d, mod);
+        card = libcrypt::pow_mod(card, key_d, ctx, libcrypt::pow_mode::constant_time);
     }
 }
 
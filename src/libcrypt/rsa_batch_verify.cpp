@@ -0,0 +1,179 @@
+#include <libcrypt/rsa_batch_verify.hpp>
+#include <libcrypt/utils.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+
+namespace libcrypt {
+
+libcrypt::RsaBatchVerifier::RsaBatchVerifier(int64_t mod, int64_t shared_key)
+    : ctx(mod), shared_key(shared_key), mt(std::random_device{}())
+{
+}
+
+bool libcrypt::RsaBatchVerifier::check_one(int64_t hash, int64_t signature) const
+{
+    return libcrypt::pow_mod(signature, shared_key, ctx, libcrypt::pow_mode::sliding_window) == hash;
+}
+
+bool libcrypt::RsaBatchVerifier::check_combined(std::span<const int64_t> hashes, std::span<const int64_t> signatures)
+{
+    const int64_t mod = ctx.get_mod();
+    int64_t signatures_product = 1;
+    int64_t hashes_product = 1;
+
+    std::vector<int64_t> exps(libcrypt::multi_pow_max_bases);
+
+    for (std::size_t i = 0; i < hashes.size(); i += libcrypt::multi_pow_max_bases)
+    {
+        const std::size_t count = std::min(libcrypt::multi_pow_max_bases, hashes.size() - i);
+
+        // odd, so a single bad pair whose ratio is -1 still shows up
+        for (std::size_t j = 0; j < count; j++)
+        {
+            exps[j] = static_cast<int64_t>((mt() & ((uint64_t{1} << libcrypt::rsa_batch_exp_bits) - 1)) | 1);
+        }
+
+        const std::span<const int64_t> group_exps{exps.data(), count};
+
+        signatures_product = libcrypt::mulmod(
+            signatures_product, libcrypt::multi_pow_mod(signatures.subspan(i, count), group_exps, ctx), mod);
+        hashes_product
+            = libcrypt::mulmod(hashes_product, libcrypt::multi_pow_mod(hashes.subspan(i, count), group_exps, ctx), mod);
+    }
+
+    return libcrypt::pow_mod(signatures_product, shared_key, ctx, libcrypt::pow_mode::sliding_window) == hashes_product;
+}
+
+void libcrypt::RsaBatchVerifier::screen_batch(
+    std::span<const int64_t> hashes,
+    std::span<const int64_t> signatures,
+    std::span<const std::size_t> indices,
+    std::vector<bool>& valid)
+{
+    if (indices.size() <= libcrypt::rsa_batch_min_size)
+    {
+        for (const std::size_t i : indices)
+        {
+            valid[i] = check_one(hashes[i], signatures[i]);
+        }
+        return;
+    }
+
+    std::vector<int64_t> batch_hashes;
+    std::vector<int64_t> batch_signatures;
+    batch_hashes.reserve(indices.size());
+    batch_signatures.reserve(indices.size());
+
+    for (const std::size_t i : indices)
+    {
+        batch_hashes.emplace_back(hashes[i]);
+        batch_signatures.emplace_back(signatures[i]);
+    }
+
+    if (check_combined(batch_hashes, batch_signatures))
+    {
+        for (const std::size_t i : indices)
+        {
+            valid[i] = true;
+        }
+        return;
+    }
+
+    const std::size_t half = indices.size() / 2;
+    screen_batch(hashes, signatures, indices.first(half), valid);
+    screen_batch(hashes, signatures, indices.subspan(half), valid);
+}
+
+std::vector<bool> libcrypt::RsaBatchVerifier::check_distinct(
+    std::span<const int64_t> hashes,
+    std::span<const int64_t> signatures,
+    bool combine)
+{
+    if (hashes.size() != signatures.size())
+    {
+        throw std::runtime_error{"Every hash needs exactly one signature"};
+    }
+
+    const int64_t mod = ctx.get_mod();
+
+    // (hash, signature mod n, position) of every pair that can be valid at all; pow_mod keeps the sign of a
+    // negative signature, so its power never equals a hash
+    std::vector<std::tuple<int64_t, int64_t, std::size_t>> pairs;
+    pairs.reserve(hashes.size());
+
+    for (std::size_t i = 0; i < hashes.size(); i++)
+    {
+        if (hashes[i] >= 0 && hashes[i] < mod && signatures[i] >= 0)
+        {
+            pairs.emplace_back(hashes[i], signatures[i] % mod, i);
+        }
+    }
+
+    std::ranges::sort(pairs);
+
+    std::vector<int64_t> unique_hashes;
+    std::vector<int64_t> unique_signatures;
+    std::vector<std::size_t> pair_unique(pairs.size());
+
+    for (std::size_t i = 0; i < pairs.size(); i++)
+    {
+        const auto& [hash, signature, position] = pairs[i];
+
+        if (unique_hashes.empty() || unique_hashes.back() != hash || unique_signatures.back() != signature)
+        {
+            unique_hashes.emplace_back(hash);
+            unique_signatures.emplace_back(signature);
+        }
+
+        pair_unique[i] = unique_hashes.size() - 1;
+    }
+
+    std::vector<bool> unique_valid(unique_hashes.size());
+    std::vector<std::size_t> screened;
+
+    // a combined check only holds for units, and doesn't pay off for short public exponents
+    combine = combine && std::bit_width(static_cast<uint64_t>(shared_key)) > libcrypt::rsa_batch_exp_bits;
+
+    for (std::size_t i = 0; i < unique_hashes.size(); i++)
+    {
+        if (combine && libcrypt::binary_gcd(unique_hashes[i], mod) == 1
+            && libcrypt::binary_gcd(unique_signatures[i], mod) == 1)
+        {
+            screened.emplace_back(i);
+        }
+        else
+        {
+            unique_valid[i] = check_one(unique_hashes[i], unique_signatures[i]);
+        }
+    }
+
+    screen_batch(unique_hashes, unique_signatures, screened, unique_valid);
+
+    std::vector<bool> valid(hashes.size());
+
+    for (std::size_t i = 0; i < pairs.size(); i++)
+    {
+        valid[std::get<2>(pairs[i])] = unique_valid[pair_unique[i]];
+    }
+
+    return valid;
+}
+
+std::vector<bool> libcrypt::RsaBatchVerifier::verify(
+    std::span<const int64_t> hashes,
+    std::span<const int64_t> signatures)
+{
+    return check_distinct(hashes, signatures, false);
+}
+
+std::vector<bool> libcrypt::RsaBatchVerifier::screen(
+    std::span<const int64_t> hashes,
+    std::span<const int64_t> signatures)
+{
+    return check_distinct(hashes, signatures, true);
+}
+
+}  // namespace libcrypt
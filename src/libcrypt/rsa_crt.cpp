@@ -0,0 +1,37 @@
+#include <libcrypt/rsa_crt.hpp>
+#include <libcrypt/utils.hpp>
+#include <cstdint>
+#include <stdexcept>
+
+namespace libcrypt {
+
+libcrypt::rsa_private_key make_rsa_private_key(int64_t p, int64_t q, int64_t private_exp)
+{
+    const int64_t q_inv = libcrypt::inverse_mod(q, p);
+
+    if (p == q || q_inv < 0)
+    {
+        throw std::runtime_error{"RSA modulus factors must be distinct primes"};
+    }
+
+    return {p, q, libcrypt::mod(private_exp, p - 1), libcrypt::mod(private_exp, q - 1), q_inv};
+}
+
+libcrypt::RsaCrt::RsaCrt(const libcrypt::rsa_private_key& key) : key(key), p_ctx(key.p), q_ctx(key.q) {}
+
+int64_t libcrypt::RsaCrt::pow(int64_t value) const
+{
+    // d is odd because p - 1 is even and d is invertible modulo (p - 1)(q - 1), so dp has the parity of d
+    const bool negate = (value < 0) && (key.dp & 1);
+    const int64_t magnitude = (value < 0) ? -value : value;
+
+    const int64_t p_part = libcrypt::pow_mod(magnitude, key.dp, p_ctx, libcrypt::pow_mode::constant_time);
+    const int64_t q_part = libcrypt::pow_mod(magnitude, key.dq, q_ctx, libcrypt::pow_mode::constant_time);
+
+    const int64_t h = libcrypt::mulmod(key.q_inv, libcrypt::mod(p_part - q_part, key.p), key.p);
+    const int64_t result = q_part + h * key.q;
+
+    return negate ? -result : result;
+}
+
+}  // namespace libcrypt
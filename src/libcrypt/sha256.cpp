@@ -0,0 +1,299 @@
+#include <libcrypt/sha256.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <span>
+#include <string>
+#include <string_view>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LIBCRYPT_SHA_NI
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace libcrypt {
+
+alignas(16) constexpr std::array<uint32_t, 64> sha256_round_consts{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr std::array<uint32_t, 8> sha256_initial_state{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+static uint32_t load_be32(const unsigned char* data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+           | (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+static void compress_scalar(uint32_t* state, const unsigned char* blocks, std::size_t blocks_num)
+{
+    for (; blocks_num > 0; blocks_num--, blocks += Sha256::block_size)
+    {
+        // 16-word ring buffer instead of the full 64-word schedule
+        std::array<uint32_t, 16> w{};
+
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+        uint32_t f = state[5];
+        uint32_t g = state[6];
+        uint32_t h = state[7];
+
+        for (std::size_t i = 0; i < 64; i++)
+        {
+            uint32_t& word = w[i & 15];
+
+            if (i < 16)
+            {
+                word = libcrypt::load_be32(blocks + 4 * i);
+            }
+            else
+            {
+                const uint32_t w15 = w[(i - 15) & 15];
+                const uint32_t w2 = w[(i - 2) & 15];
+                word += (std::rotr(w15, 7) ^ std::rotr(w15, 18) ^ (w15 >> 3)) + w[(i - 7) & 15]
+                        + (std::rotr(w2, 17) ^ std::rotr(w2, 19) ^ (w2 >> 10));
+            }
+
+            const uint32_t t1 = h + (std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25)) + ((e & f) ^ (~e & g))
+                                + libcrypt::sha256_round_consts[i] + word;
+            const uint32_t t2 = (std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef LIBCRYPT_SHA_NI
+
+__attribute__((target("sha,sse4.1"))) static void compress_sha_ni(
+    uint32_t* state,
+    const unsigned char* blocks,
+    std::size_t blocks_num)
+{
+    const __m128i byte_swap_mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // the sha256rnds2 instruction keeps the state as ABEF/CDGH halves
+    const __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+    const __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+    __m128i abef = _mm_alignr_epi8(dcba, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, dcba, 0xF0);
+
+    for (; blocks_num > 0; blocks_num--, blocks += Sha256::block_size)
+    {
+        const __m128i abef_save = abef;
+        const __m128i cdgh_save = cdgh;
+
+        __m128i msg[4];
+
+        for (std::size_t i = 0; i < 4; i++)
+        {
+            msg[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16 * i)), byte_swap_mask);
+        }
+
+        for (std::size_t i = 0; i < 16; i++)
+        {
+            const __m128i round_input = _mm_add_epi32(
+                msg[i & 3],
+                _mm_load_si128(reinterpret_cast<const __m128i*>(libcrypt::sha256_round_consts.data() + 4 * i)));
+
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, round_input);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(round_input, 0x0E));
+
+            if (i < 12)
+            {
+                const __m128i schedule = _mm_add_epi32(
+                    _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]),
+                    _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                msg[i & 3] = _mm_sha256msg2_epu32(schedule, msg[(i + 3) & 3]);
+            }
+        }
+
+        abef = _mm_add_epi32(abef, abef_save);
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+static bool cpu_has_sha_ni()
+{
+    constexpr unsigned ssse3_bit = 1U << 9;
+    constexpr unsigned sse41_bit = 1U << 19;
+    constexpr unsigned sha_bit = 1U << 29;
+
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & ssse3_bit) == 0 || (ecx & sse41_bit) == 0)
+    {
+        return false;
+    }
+
+    return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & sha_bit) != 0;
+}
+
+#endif
+
+bool is_sha256_backend_supported(libcrypt::sha256_backend backend)
+{
+    switch (backend)
+    {
+        case libcrypt::sha256_backend::scalar:
+            return true;
+        case libcrypt::sha256_backend::sha_ni:
+        {
+#ifdef LIBCRYPT_SHA_NI
+            static const bool has_sha_ni = libcrypt::cpu_has_sha_ni();
+            return has_sha_ni;
+#else
+            return false;
+#endif
+        }
+    }
+
+    return false;
+}
+
+libcrypt::sha256_backend best_sha256_backend()
+{
+    return libcrypt::is_sha256_backend_supported(libcrypt::sha256_backend::sha_ni) ? libcrypt::sha256_backend::sha_ni
+                                                                                    : libcrypt::sha256_backend::scalar;
+}
+
+libcrypt::Sha256::Sha256(libcrypt::sha256_backend backend)
+    : state(libcrypt::sha256_initial_state), compress(libcrypt::compress_scalar)
+{
+    if (!libcrypt::is_sha256_backend_supported(backend))
+    {
+        throw std::runtime_error{"sha256 backend isn't supported by this cpu"};
+    }
+
+#ifdef LIBCRYPT_SHA_NI
+    if (backend == libcrypt::sha256_backend::sha_ni)
+    {
+        compress = libcrypt::compress_sha_ni;
+    }
+#endif
+}
+
+void libcrypt::Sha256::update(std::span<const char> data)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    std::size_t size = data.size();
+    total_size += size;
+
+    if (pending_size > 0)
+    {
+        const std::size_t taken = std::min(size, block_size - pending_size);
+        std::memcpy(pending.data() + pending_size, bytes, taken);
+        pending_size += taken;
+        bytes += taken;
+        size -= taken;
+
+        if (pending_size < block_size)
+        {
+            return;
+        }
+
+        compress(state.data(), pending.data(), 1);
+        pending_size = 0;
+    }
+
+    compress(state.data(), bytes, size / block_size);
+    bytes += size - size % block_size;
+    size %= block_size;
+
+    std::memcpy(pending.data(), bytes, size);
+    pending_size = size;
+}
+
+std::array<unsigned char, libcrypt::Sha256::digest_size> libcrypt::Sha256::finish()
+{
+    constexpr std::size_t length_size = sizeof(uint64_t);
+    const uint64_t total_bits = total_size * 8;
+
+    pending[pending_size++] = 0x80;
+
+    if (pending_size > block_size - length_size)
+    {
+        std::memset(pending.data() + pending_size, 0, block_size - pending_size);
+        compress(state.data(), pending.data(), 1);
+        pending_size = 0;
+    }
+
+    std::memset(pending.data() + pending_size, 0, block_size - length_size - pending_size);
+
+    for (std::size_t i = 0; i < length_size; i++)
+    {
+        pending[block_size - 1 - i] = static_cast<unsigned char>(total_bits >> (8 * i));
+    }
+
+    compress(state.data(), pending.data(), 1);
+
+    std::array<unsigned char, digest_size> digest{};
+
+    for (std::size_t i = 0; i < state.size(); i++)
+    {
+        for (std::size_t j = 0; j < sizeof(uint32_t); j++)
+        {
+            digest[4 * i + j] = static_cast<unsigned char>(state[i] >> (24 - 8 * j));
+        }
+    }
+
+    return digest;
+}
+
+std::string libcrypt::Sha256::finish_hex()
+{
+    constexpr std::string_view hex_digits = "0123456789abcdef";
+
+    std::string hex;
+    hex.reserve(2 * digest_size);
+
+    for (const unsigned char byte : finish())
+    {
+        hex += hex_digits[byte >> 4];
+        hex += hex_digits[byte & 0x0F];
+    }
+
+    return hex;
+}
+
+}  // namespace libcrypt
@@ -1,79 +1,177 @@
 #include <libcrypt/signatures.hpp>
 #include <libcrypt/utils.hpp>
-#include <PicoSHA2/picosha2.h>
+#include <libcrypt/block_io.hpp>
+#include <libcrypt/chunk_pipeline.hpp>
+#include <libcrypt/sha256.hpp>
+#include <libcrypt/fixed_base_pow.hpp>
+#include <libcrypt/rsa_batch_verify.hpp>
 #include <string>
-#include <iterator>
 #include <fstream>
 #include <vector>
 #include <cstdint>
+#include <climits>
+#include <bit>
 #include <limits>
-#include <cstdio>
+#include <algorithm>
+#include <exception>
 #include <random>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <thread>
 
 namespace libcrypt {
 
 constexpr int64_t file_hash_size = 64 * sizeof(int32_t);
+constexpr std::string_view hex_digits = "0123456789abcdef";
 
+// the next block is read on its own thread while the current one is hashed on the caller's thread
 std::string calc_file_hash(std::fstream& file)
 {
-    std::vector<unsigned char> bin_file_hash(picosha2::k_digest_size);
-    picosha2::hash256(
-        std::istreambuf_iterator<char>(file),
-        std::istreambuf_iterator<char>(),
-        bin_file_hash.begin(),
-        bin_file_hash.end());
-    return picosha2::bytes_to_hex_string(bin_file_hash.begin(), bin_file_hash.end());
+    libcrypt::Sha256 hasher;
+
+    libcrypt::process_chunks_in_order<std::vector<char>>(
+        0,
+        true,
+        [&](std::vector<char>& block) { return libcrypt::read_block(file, block, libcrypt::default_block_size); },
+        [](std::vector<char>&, unsigned) {},
+        [&](const std::vector<char>& block) { hasher.update(block); });
+
+    // signing appends to the same stream right after hashing it
+    file.clear();
+
+    return hasher.finish_hex();
 }
 
-void rsa_file_signing(int64_t mod, int64_t send_private_key, std::fstream& file)
+std::string calc_file_hash(std::istream& file, int64_t data_size)
+{
+    libcrypt::Sha256 hasher;
+
+    // a single block has nothing to overlap with
+    const bool prefetch = data_size > static_cast<int64_t>(libcrypt::default_block_size);
+
+    libcrypt::process_chunks_in_order<std::vector<char>>(
+        0,
+        prefetch,
+        [&](std::vector<char>& block) {
+            if (data_size == 0)
+            {
+                return false;
+            }
+
+            const auto block_size
+                = std::min<std::size_t>(static_cast<std::size_t>(data_size), libcrypt::default_block_size);
+            if (!libcrypt::read_block(file, block, block_size))
+            {
+                throw std::runtime_error{"file is shorter than its signed data"};
+            }
+
+            data_size -= static_cast<int64_t>(block.size());
+            return true;
+        },
+        [](std::vector<char>&, unsigned) {},
+        [&](const std::vector<char>& block) { hasher.update(block); });
+
+    return hasher.finish_hex();
+}
+
+// RSA signs hash characters independently, and a hex digest only ever has 16 of them
+using hex_sign_table = std::array<int32_t, UCHAR_MAX + 1>;
+
+template <typename Sign>
+static libcrypt::hex_sign_table make_hex_sign_table(Sign sign)
+{
+    libcrypt::hex_sign_table table{};
+
+    for (const char digit : libcrypt::hex_digits)
+    {
+        table[static_cast<unsigned char>(digit)] = static_cast<int32_t>(sign(static_cast<int64_t>(digit)));
+    }
+
+    return table;
+}
+
+static libcrypt::hex_sign_table make_rsa_sign_table(const libcrypt::rsa_private_key& send_private_key)
+{
+    const libcrypt::RsaCrt crt(send_private_key);
+
+    return libcrypt::make_hex_sign_table([&](int64_t hash_part) { return crt.pow(hash_part); });
+}
+
+static void rsa_write_sign(const libcrypt::hex_sign_table& sign_table, std::fstream& file)
 {
     const std::string file_hash{libcrypt::calc_file_hash(file)};
 
     for (const char& hash_part : file_hash)
     {
-        const auto signed_hash_part
-            = static_cast<int32_t>(libcrypt::pow_mod(static_cast<int64_t>(hash_part), send_private_key, mod));
+        const int32_t signed_hash_part = sign_table[static_cast<unsigned char>(hash_part)];
         file.write(reinterpret_cast<const char*>(&signed_hash_part), sizeof(signed_hash_part));
     }
 }
 
-bool rsa_check_file_sign(int64_t mod, int64_t send_shared_key, std::fstream& file)
+void rsa_file_signing(int64_t mod, int64_t send_private_key, std::fstream& file)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+
+    libcrypt::rsa_write_sign(
+        libcrypt::make_hex_sign_table([&](int64_t hash_part) {
+            return libcrypt::pow_mod(hash_part, send_private_key, ctx, libcrypt::pow_mode::constant_time);
+        }),
+        file);
+}
+
+void rsa_file_signing(const libcrypt::rsa_private_key& send_private_key, std::fstream& file)
+{
+    libcrypt::rsa_write_sign(libcrypt::make_rsa_sign_table(send_private_key), file);
+}
+
+// false if the file is too short to end with a signature
+static bool rsa_read_sign(std::fstream& file, std::vector<int64_t>& hash_parts, std::vector<int64_t>& signed_hash_parts)
 {
     file.seekg(-1 * file_hash_size, std::ios::end);
     const int64_t data_size = file.tellg();
-    file.seekg(std::ios::beg);
-
-    std::fstream file_data("tmp.txt", std::ios::binary | std::ios::out | std::ios::in | std::ios::app);
 
-    if (!file_data.is_open())
+    if (data_size < 0)
     {
-        throw std::runtime_error{"can't create tmp buf file in rsa sign\n"};
+        return false;
     }
 
-    std::copy_n(std::istreambuf_iterator<char>(file), data_size, std::ostreambuf_iterator<char>(file_data));
-
-    file_data.seekg(std::ios::beg);
+    file.seekg(std::ios::beg);
 
-    const std::string file_hash{libcrypt::calc_file_hash(file_data)};
+    const std::string file_hash{libcrypt::calc_file_hash(file, data_size)};
 
     file.seekg(-1 * file_hash_size, std::ios::end);
 
-    for (const auto& hash_part : file_hash)
-    {
-        int32_t signed_hash_part = 0;
-        file.read(reinterpret_cast<char*>(&signed_hash_part), sizeof(signed_hash_part));
+    std::vector<int32_t> sign(file_hash.size());
+    file.read(reinterpret_cast<char*>(sign.data()), file_hash_size);
+
+    hash_parts.assign(file_hash.begin(), file_hash.end());
+    signed_hash_parts.assign(sign.begin(), sign.end());
 
-        if (hash_part != libcrypt::pow_mod(static_cast<int64_t>(signed_hash_part), send_shared_key, mod))
-        {
-            static_cast<void>(std::remove("tmp.txt"));
-            return false;
-        }
-    }
-    static_cast<void>(std::remove("tmp.txt"));
     return true;
 }
 
-void elgamal_file_signing(
+bool rsa_check_file_sign(int64_t mod, int64_t send_shared_key, std::fstream& file)
+{
+    std::vector<int64_t> hash_parts;
+    std::vector<int64_t> signed_hash_parts;
+
+    if (!libcrypt::rsa_read_sign(file, hash_parts, signed_hash_parts))
+    {
+        return false;
+    }
+
+    const std::vector<bool> valid
+        = libcrypt::RsaBatchVerifier(mod, send_shared_key).verify(hash_parts, signed_hash_parts);
+
+    return std::ranges::find(valid, false) == valid.end();
+}
+
+static void elgamal_write_sign(
+    const libcrypt::MontgomeryContext& ctx,
     libcrypt::dh_system_params sys_params,
     int64_t session_key,
     int64_t recv_private_key,
@@ -81,67 +179,111 @@ void elgamal_file_signing(
 {
     const std::string file_hash{libcrypt::calc_file_hash(file)};
 
-    const auto sign_first = static_cast<int32_t>(libcrypt::pow_mod(sys_params.base, session_key, sys_params.mod));
+    const auto sign_first
+        = static_cast<int32_t>(libcrypt::pow_mod(sys_params.base, session_key, ctx, libcrypt::pow_mode::constant_time));
     file.write(reinterpret_cast<const char*>(&sign_first), sizeof(sign_first));
 
-    const int64_t inv_session_key = libcrypt::extended_gcd(sys_params.mod - 1, session_key).back();
+    const int64_t inv_session_key = libcrypt::inverse_mod(session_key, sys_params.mod - 1);
+
+    const int64_t signed_private_key = libcrypt::mulmod(recv_private_key, sign_first, sys_params.mod - 1);
 
     for (const auto& hash_part : file_hash)
     {
         const auto signed_hash_part = static_cast<int32_t>(libcrypt::mod(
-            inv_session_key
-                * (libcrypt::mod(static_cast<int64_t>(hash_part) - recv_private_key * sign_first, sys_params.mod - 1)),
+            libcrypt::mulmod(
+                inv_session_key,
+                libcrypt::mod(static_cast<int64_t>(hash_part) - signed_private_key, sys_params.mod - 1),
+                sys_params.mod - 1),
             sys_params.mod - 1));
 
         file.write(reinterpret_cast<const char*>(&signed_hash_part), sizeof(signed_hash_part));
     }
 }
 
-bool elgamal_check_file_sign(libcrypt::dh_system_params sys_params, int64_t recv_shared_key, std::fstream& file)
+void elgamal_file_signing(
+    libcrypt::dh_system_params sys_params,
+    int64_t session_key,
+    int64_t recv_private_key,
+    std::fstream& file)
 {
-    constexpr int64_t sign_size = file_hash_size + sizeof(int32_t);
+    libcrypt::elgamal_write_sign(
+        libcrypt::MontgomeryContext(sys_params.mod), sys_params, session_key, recv_private_key, file);
+}
 
-    file.seekg(-1 * sign_size, std::ios::end);
-    const int64_t data_size = file.tellg();
-    file.seekg(std::ios::beg);
+// every signature needs its own session key, reusing one reveals the private key
+static int64_t gen_elgamal_session_key(int64_t mod, std::mt19937& mt)
+{
+    std::uniform_int_distribution<int64_t> session_key_range(1, mod - 2);
+    int64_t session_key = 0;
+
+    do
+    {
+        session_key = session_key_range(mt);
+    } while (libcrypt::binary_gcd(session_key, mod - 1) != 1);
 
-    std::fstream file_data("tmp.txt", std::ios::binary | std::ios::out | std::ios::in | std::ios::app);
+    return session_key;
+}
+
+// Key tables shared by every file checked against one ElGamal public key
+struct elgamal_check_tables
+{
+    libcrypt::MontgomeryContext ctx;
+    libcrypt::FixedBasePow base_pow;
 
-    if (!file_data.is_open())
+    explicit elgamal_check_tables(libcrypt::dh_system_params sys_params)
+        : ctx(sys_params.mod), base_pow(sys_params.base, ctx, CHAR_BIT)
     {
-        throw std::runtime_error{"can't create tmp buf file in elgamal sign\n"};
     }
+};
 
-    std::copy_n(std::istreambuf_iterator<char>(file), data_size, std::ostreambuf_iterator<char>(file_data));
+static bool elgamal_check_sign(
+    const libcrypt::elgamal_check_tables& tables,
+    libcrypt::dh_system_params sys_params,
+    int64_t recv_shared_key,
+    std::fstream& file)
+{
+    constexpr int64_t sign_size = file_hash_size + sizeof(int32_t);
 
-    file_data.seekg(std::ios::beg);
+    file.seekg(-1 * sign_size, std::ios::end);
+    const int64_t data_size = file.tellg();
+    file.seekg(std::ios::beg);
 
-    const std::string file_hash{libcrypt::calc_file_hash(file_data)};
+    const std::string file_hash{libcrypt::calc_file_hash(file, data_size)};
 
     file.seekg(-1 * sign_size, std::ios::end);
 
     int32_t sign_first = 0;
     file.read(reinterpret_cast<char*>(&sign_first), sizeof(sign_first));
 
+    // y^r is the same for every hash character, g and r are raised to 64 exponents each
+    const int64_t shared_key_pow
+        = libcrypt::pow_mod(recv_shared_key, sign_first, tables.ctx, libcrypt::pow_mode::sliding_window);
+    const libcrypt::FixedBasePow sign_first_pow(sign_first, tables.ctx, std::numeric_limits<int32_t>::digits);
+
     for (const auto& hash_part : file_hash)
     {
         int32_t signed_hash_part = 0;
         file.read(reinterpret_cast<char*>(&signed_hash_part), sizeof(signed_hash_part));
 
-        if (libcrypt::pow_mod(sys_params.base, static_cast<int64_t>(hash_part), sys_params.mod)
-            != libcrypt::mod(
-                libcrypt::pow_mod(recv_shared_key, sign_first, sys_params.mod)
-                    * libcrypt::pow_mod(sign_first, static_cast<int64_t>(signed_hash_part), sys_params.mod),
-                sys_params.mod))
+        if (signed_hash_part < 0)
+        {
+            return false;
+        }
+
+        if (tables.base_pow.pow(static_cast<unsigned char>(hash_part))
+            != libcrypt::mulmod(shared_key_pow, sign_first_pow.pow(signed_hash_part), sys_params.mod))
         {
-            static_cast<void>(std::remove("tmp.txt"));
             return false;
         }
     }
-    static_cast<void>(std::remove("tmp.txt"));
     return true;
 }
 
+bool elgamal_check_file_sign(libcrypt::dh_system_params sys_params, int64_t recv_shared_key, std::fstream& file)
+{
+    return libcrypt::elgamal_check_sign(libcrypt::elgamal_check_tables(sys_params), sys_params, recv_shared_key, file);
+}
+
 static bool gost_hash_to_sign(
     const std::string& file_hash,
     int8_t sign_length,
@@ -153,7 +295,10 @@ static bool gost_hash_to_sign(
     for (char i = 1; i < sign_length; i++)
     {
         signature.emplace_back(static_cast<int32_t>(
-            libcrypt::mod(rand_num * file_hash.at(i - 1) + send_private_key * signature.at(0), elliptic_exp)));
+            libcrypt::mod(
+                libcrypt::mulmod(rand_num, file_hash.at(i - 1), elliptic_exp)
+                    + libcrypt::mulmod(send_private_key, signature.at(0), elliptic_exp),
+                elliptic_exp)));
 
         if (signature[i] == 0)
         {
@@ -164,11 +309,12 @@ static bool gost_hash_to_sign(
     return true;
 }
 
-void gost_file_signing(
-    int64_t mod,
+static void gost_write_sign(
+    const libcrypt::MontgomeryContext& ctx,
     int64_t elliptic_exp,
     int64_t elliptic_coef,
     int64_t send_private_key,
+    std::mt19937& mt,
     std::fstream& file)
 {
     constexpr int16_t sign_size = file_hash_size + sizeof(int32_t);
@@ -176,8 +322,6 @@ void gost_file_signing(
 
     const std::string file_hash{libcrypt::calc_file_hash(file)};
 
-    std::random_device rd;
-    std::mt19937 mt(rd());
     std::uniform_int_distribution<int64_t> rand_num_gen_range(1, elliptic_exp - 1);
 
     while (true)
@@ -186,8 +330,8 @@ void gost_file_signing(
         std::vector<int32_t> signature;
         signature.reserve(sign_length);
 
-        signature.emplace_back(
-            static_cast<int32_t>(libcrypt::mod(libcrypt::pow_mod(elliptic_coef, rand_num, mod), elliptic_exp)));
+        signature.emplace_back(static_cast<int32_t>(libcrypt::mod(
+            libcrypt::pow_mod(elliptic_coef, rand_num, ctx, libcrypt::pow_mode::constant_time), elliptic_exp)));
 
         if (signature[0] == 0)
         {
@@ -205,31 +349,48 @@ void gost_file_signing(
     }
 }
 
-bool gost_check_file_sign(
+void gost_file_signing(
     int64_t mod,
     int64_t elliptic_exp,
     int64_t elliptic_coef,
-    int64_t send_shared_key,
+    int64_t send_private_key,
     std::fstream& file)
 {
-    constexpr int64_t sign_size = file_hash_size + sizeof(int32_t);
-
-    file.seekg(-1 * sign_size, std::ios::end);
-    const int64_t data_size = file.tellg();
-    file.seekg(std::ios::beg);
+    std::random_device rd;
+    std::mt19937 mt(rd());
 
-    std::fstream file_data("tmp.txt", std::ios::binary | std::ios::out | std::ios::in | std::ios::app);
+    libcrypt::gost_write_sign(
+        libcrypt::MontgomeryContext(mod), elliptic_exp, elliptic_coef, send_private_key, mt, file);
+}
 
-    if (!file_data.is_open())
+// Key tables shared by every file checked against one GOST public key
+struct gost_check_tables
+{
+    libcrypt::MontgomeryContext ctx;
+    libcrypt::FixedBasePow elliptic_coef_pow;
+    libcrypt::FixedBasePow shared_key_pow;
+
+    gost_check_tables(int64_t mod, int64_t elliptic_exp, int64_t elliptic_coef, int64_t send_shared_key)
+        : ctx(mod),
+          elliptic_coef_pow(elliptic_coef, ctx, std::bit_width(static_cast<uint64_t>(elliptic_exp))),
+          shared_key_pow(send_shared_key, ctx, std::bit_width(static_cast<uint64_t>(elliptic_exp)))
     {
-        throw std::runtime_error{"can't create tmp buf file in gost sign\n"};
     }
+};
 
-    std::copy_n(std::istreambuf_iterator<char>(file), data_size, std::ostreambuf_iterator<char>(file_data));
+static bool gost_check_sign(
+    const libcrypt::gost_check_tables& tables,
+    int64_t mod,
+    int64_t elliptic_exp,
+    std::fstream& file)
+{
+    constexpr int64_t sign_size = file_hash_size + sizeof(int32_t);
 
-    file_data.seekg(std::ios::beg);
+    file.seekg(-1 * sign_size, std::ios::end);
+    const int64_t data_size = file.tellg();
+    file.seekg(std::ios::beg);
 
-    const std::string file_hash{libcrypt::calc_file_hash(file_data)};
+    const std::string file_hash{libcrypt::calc_file_hash(file, data_size)};
 
     file.seekg(-1 * sign_size, std::ios::end);
 
@@ -241,7 +402,11 @@ bool gost_check_file_sign(
         return false;
     }
 
-    for (const auto& hash_part : file_hash)
+    const std::vector<int64_t> hash_parts(file_hash.begin(), file_hash.end());
+    std::vector<int64_t> inversions(hash_parts.size());
+    libcrypt::batch_inverse_mod(hash_parts, inversions, elliptic_exp);
+
+    for (const int64_t inversion : inversions)
     {
         int32_t signed_hash_part = 0;
         file.read(reinterpret_cast<char*>(&signed_hash_part), sizeof(signed_hash_part));
@@ -251,25 +416,207 @@ bool gost_check_file_sign(
             return false;
         }
 
-        const int64_t inversion = libcrypt::extended_gcd(hash_part, elliptic_exp).back();
+        const int64_t coef_exp
+            = libcrypt::mod(libcrypt::mulmod(signed_hash_part, inversion, elliptic_exp), elliptic_exp);
+        const int64_t key_exp = libcrypt::mod(
+            libcrypt::mulmod(-1 * static_cast<int64_t>(sign_first), inversion, elliptic_exp), elliptic_exp);
 
         if (sign_first
             != libcrypt::mod(
-                libcrypt::mod(
-                    libcrypt::pow_mod(elliptic_coef, libcrypt::mod(signed_hash_part * inversion, elliptic_exp), mod)
-                        * libcrypt::pow_mod(
-                            send_shared_key,
-                            libcrypt::mod(-1 * static_cast<int64_t>(sign_first) * inversion, elliptic_exp),
-                            mod),
-                    mod),
+                libcrypt::mulmod(tables.elliptic_coef_pow.pow(coef_exp), tables.shared_key_pow.pow(key_exp), mod),
                 elliptic_exp))
         {
-            static_cast<void>(std::remove("tmp.txt"));
             return false;
         }
     }
-    static_cast<void>(std::remove("tmp.txt"));
     return true;
 }
 
-}  // namespace libcrypt
\ No newline at end of file
+bool gost_check_file_sign(
+    int64_t mod,
+    int64_t elliptic_exp,
+    int64_t elliptic_coef,
+    int64_t send_shared_key,
+    std::fstream& file)
+{
+    return libcrypt::gost_check_sign(
+        libcrypt::gost_check_tables(mod, elliptic_exp, elliptic_coef, send_shared_key), mod, elliptic_exp, file);
+}
+
+// Opens every path with mode on threads_num workers, each with its own random engine. Signing needs
+// std::ios::out to append, checking only reads, so read-only files can be checked.
+// process(index, file, mt) returns the per-file outcome; exceptions only fail the file that raised them.
+static std::vector<libcrypt::file_sign_result> process_files(
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num,
+    std::ios::openmode mode,
+    const std::function<bool(std::size_t, std::fstream&, std::mt19937&)>& process)
+{
+    std::vector<libcrypt::file_sign_result> results(paths.size());
+    std::atomic<std::size_t> next{0};
+    std::random_device rd;
+
+    const auto worker = [&](std::mt19937::result_type seed) {
+        std::mt19937 mt(seed);
+
+        for (std::size_t i = next++; i < paths.size(); i = next++)
+        {
+            results[i].path = paths[i];
+
+            std::fstream file(paths[i], std::ios::binary | mode);
+            if (!file.is_open())
+            {
+                results[i].error = "can't open \"" + paths[i].string() + '"';
+                continue;
+            }
+
+            try
+            {
+                results[i].ok = process(i, file, mt);
+            }
+            catch (const std::exception& error)
+            {
+                results[i].error = error.what();
+            }
+        }
+    };
+
+    const auto workers_num = static_cast<unsigned>(std::clamp<std::size_t>(paths.size(), 1, std::max(threads_num, 1U)));
+
+    if (workers_num == 1)
+    {
+        worker(rd());
+        return results;
+    }
+
+    std::vector<std::jthread> workers;
+    workers.reserve(workers_num);
+
+    for (unsigned i = 0; i < workers_num; i++)
+    {
+        workers.emplace_back(worker, rd());
+    }
+
+    workers.clear();
+
+    return results;
+}
+
+std::vector<libcrypt::file_sign_result> rsa_files_signing(
+    const libcrypt::rsa_private_key& send_private_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num)
+{
+    const libcrypt::hex_sign_table sign_table = libcrypt::make_rsa_sign_table(send_private_key);
+
+    return libcrypt::process_files(
+        paths, threads_num, std::ios::in | std::ios::out, [&](std::size_t, std::fstream& file, std::mt19937&) {
+            libcrypt::rsa_write_sign(sign_table, file);
+            return true;
+        });
+}
+
+std::vector<libcrypt::file_sign_result> rsa_check_files_sign(
+    int64_t mod,
+    int64_t send_shared_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num)
+{
+    std::vector<std::vector<int64_t>> file_hash_parts(paths.size());
+    std::vector<std::vector<int64_t>> file_signed_hash_parts(paths.size());
+
+    std::vector<libcrypt::file_sign_result> results = libcrypt::process_files(
+        paths, threads_num, std::ios::in, [&](std::size_t i, std::fstream& file, std::mt19937&) {
+            return libcrypt::rsa_read_sign(file, file_hash_parts[i], file_signed_hash_parts[i]);
+        });
+
+    // the signatures of all files are checked together, so a pair repeated across files is checked once
+    std::vector<int64_t> hash_parts;
+    std::vector<int64_t> signed_hash_parts;
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        hash_parts.insert(hash_parts.end(), file_hash_parts[i].begin(), file_hash_parts[i].end());
+        signed_hash_parts.insert(
+            signed_hash_parts.end(), file_signed_hash_parts[i].begin(), file_signed_hash_parts[i].end());
+    }
+
+    const std::vector<bool> valid
+        = libcrypt::RsaBatchVerifier(mod, send_shared_key).verify(hash_parts, signed_hash_parts);
+
+    auto file_valid = valid.begin();
+
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const auto file_valid_end = file_valid + static_cast<std::ptrdiff_t>(file_hash_parts[i].size());
+        results[i].ok = results[i].ok && std::find(file_valid, file_valid_end, false) == file_valid_end;
+        file_valid = file_valid_end;
+    }
+
+    return results;
+}
+
+std::vector<libcrypt::file_sign_result> elgamal_files_signing(
+    libcrypt::dh_system_params sys_params,
+    int64_t recv_private_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num)
+{
+    const libcrypt::MontgomeryContext ctx(sys_params.mod);
+
+    return libcrypt::process_files(
+        paths, threads_num, std::ios::in | std::ios::out, [&](std::size_t, std::fstream& file, std::mt19937& mt) {
+            const int64_t session_key = libcrypt::gen_elgamal_session_key(sys_params.mod, mt);
+            libcrypt::elgamal_write_sign(ctx, sys_params, session_key, recv_private_key, file);
+            return true;
+        });
+}
+
+std::vector<libcrypt::file_sign_result> elgamal_check_files_sign(
+    libcrypt::dh_system_params sys_params,
+    int64_t recv_shared_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num)
+{
+    const libcrypt::elgamal_check_tables tables(sys_params);
+
+    return libcrypt::process_files(
+        paths, threads_num, std::ios::in, [&](std::size_t, std::fstream& file, std::mt19937&) {
+            return libcrypt::elgamal_check_sign(tables, sys_params, recv_shared_key, file);
+        });
+}
+
+std::vector<libcrypt::file_sign_result> gost_files_signing(
+    int64_t mod,
+    int64_t elliptic_exp,
+    int64_t elliptic_coef,
+    int64_t send_private_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num)
+{
+    const libcrypt::MontgomeryContext ctx(mod);
+
+    return libcrypt::process_files(
+        paths, threads_num, std::ios::in | std::ios::out, [&](std::size_t, std::fstream& file, std::mt19937& mt) {
+            libcrypt::gost_write_sign(ctx, elliptic_exp, elliptic_coef, send_private_key, mt, file);
+            return true;
+        });
+}
+
+std::vector<libcrypt::file_sign_result> gost_check_files_sign(
+    int64_t mod,
+    int64_t elliptic_exp,
+    int64_t elliptic_coef,
+    int64_t send_shared_key,
+    std::span<const std::filesystem::path> paths,
+    unsigned threads_num)
+{
+    const libcrypt::gost_check_tables tables(mod, elliptic_exp, elliptic_coef, send_shared_key);
+
+    return libcrypt::process_files(
+        paths, threads_num, std::ios::in, [&](std::size_t, std::fstream& file, std::mt19937&) {
+            return libcrypt::gost_check_sign(tables, mod, elliptic_exp, file);
+        });
+}
+
+}  // namespace libcrypt
@@ -1,9 +1,14 @@
 #include <libcrypt/utils.hpp>
+#include <libcrypt/parallel_search.hpp>
 #include <cstdint>
 #include <vector>
 #include <cmath>
 #include <random>
 #include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
 
 namespace libcrypt {
 
@@ -14,22 +19,261 @@ int64_t mod(int64_t value, int64_t mod)
     return m + mod;
 }
 
-int64_t pow_mod(int64_t base, int64_t exp, int64_t mod)
+int64_t pow_mod(int64_t base, int64_t exp, int64_t mod, libcrypt::pow_mode mode)
 {
+    if (mod > 1 && (mod & 1))
     {
-        int64_t result = 1;
-        base %= mod;
-        while (exp)
+        return libcrypt::pow_mod(base, exp, libcrypt::MontgomeryContext(mod), mode);
+    }
+
+    // the binary fallback branches on exponent bits, silently using it would leak a private exponent
+    if (mode == libcrypt::pow_mode::constant_time)
+    {
+        throw std::runtime_error{"Constant time exponentiation needs an odd modulus greater than 1"};
+    }
+
+    int64_t result = 1;
+    base %= mod;
+    while (exp)
+    {
+        if (exp & 1)
         {
-            if (exp & 1)
-            {
-                result = (result * base) % mod;
-            }
-            base = (base * base) % mod;
-            exp >>= 1;
+            result = libcrypt::mulmod(result, base, mod);
+        }
+        base = libcrypt::mulmod(base, base, mod);
+        exp >>= 1;
+    }
+    return result;
+}
+
+static uint64_t binary_pow(uint64_t mont_base, uint64_t exp, const libcrypt::MontgomeryContext& ctx)
+{
+    uint64_t result = ctx.one();
+
+    while (exp)
+    {
+        if (exp & 1)
+        {
+            result = ctx.mul(result, mont_base);
+        }
+        mont_base = ctx.mul(mont_base, mont_base);
+        exp >>= 1;
+    }
+
+    return result;
+}
+
+// left-to-right over windows that start and end with a set bit, table holds base^1, base^3, ..., base^(2^w - 1)
+static uint64_t sliding_window_pow(uint64_t mont_base, uint64_t exp, const libcrypt::MontgomeryContext& ctx)
+{
+    constexpr int max_window_bits = 4;
+
+    const int exp_bits = std::bit_width(exp);
+    const int window_bits = (exp_bits > 24) ? max_window_bits : (exp_bits > 6) ? 3 : 1;
+
+    std::array<uint64_t, 1 << (max_window_bits - 1)> odd_powers{};
+    odd_powers[0] = mont_base;
+
+    const uint64_t base_square = ctx.mul(mont_base, mont_base);
+    for (size_t i = 1; i < (size_t{1} << (window_bits - 1)); i++)
+    {
+        odd_powers[i] = ctx.mul(odd_powers[i - 1], base_square);
+    }
+
+    uint64_t result = ctx.one();
+
+    for (int bit = exp_bits - 1; bit >= 0;)
+    {
+        if (((exp >> bit) & 1) == 0)
+        {
+            result = ctx.mul(result, result);
+            bit--;
+            continue;
+        }
+
+        int low_bit = std::max(bit - window_bits + 1, 0);
+        while (((exp >> low_bit) & 1) == 0)
+        {
+            low_bit++;
+        }
+
+        const uint64_t window = (exp >> low_bit) & ((uint64_t{1} << (bit - low_bit + 1)) - 1);
+
+        for (int i = low_bit; i <= bit; i++)
+        {
+            result = ctx.mul(result, result);
+        }
+        result = ctx.mul(result, odd_powers[window >> 1]);
+
+        bit = low_bit - 1;
+    }
+
+    return result;
+}
+
+// Fixed 4-bit windows over the width of the modulus: every window costs four squarings, a scan of the whole
+// table with masks instead of an indexed load, and one multiplication, whatever the exponent bits are
+static uint64_t constant_time_pow(uint64_t mont_base, uint64_t exp, const libcrypt::MontgomeryContext& ctx)
+{
+    constexpr int window_bits = 4;
+    constexpr uint64_t digit_mask = (1 << window_bits) - 1;
+
+    std::array<uint64_t, 1 << window_bits> powers{};
+    powers[0] = ctx.one();
+    for (size_t i = 1; i < powers.size(); i++)
+    {
+        powers[i] = ctx.mul(powers[i - 1], mont_base);
+    }
+
+    const int exp_bits = std::max(std::bit_width(static_cast<uint64_t>(ctx.get_mod())), std::bit_width(exp));
+    const int windows_num = (exp_bits + window_bits - 1) / window_bits;
+
+    uint64_t result = ctx.one();
+
+    for (int window = windows_num - 1; window >= 0; window--)
+    {
+        for (int i = 0; i < window_bits; i++)
+        {
+            result = ctx.mul(result, result);
+        }
+
+        const uint64_t digit = (exp >> (window * window_bits)) & digit_mask;
+        uint64_t selected = 0;
+
+        for (uint64_t i = 0; i < powers.size(); i++)
+        {
+            selected |= powers[i] & (0 - static_cast<uint64_t>(i == digit));
         }
-        return result;
+
+        result = ctx.mul(result, selected);
+    }
+
+    return result;
+}
+
+// keeps the sign convention of pow_mod(base, exp, mod): result is negative for odd powers of a negative base
+int64_t pow_mod(int64_t base, int64_t exp, const libcrypt::MontgomeryContext& ctx, libcrypt::pow_mode mode)
+{
+    const uint64_t mont_base = ctx.to_form(base < 0 ? -(base % ctx.get_mod()) : base);
+    const bool negate = (base < 0) && (exp & 1);
+
+    if (exp < 0 && mode != libcrypt::pow_mode::binary)
+    {
+        throw std::runtime_error{"Exponent must be non-negative"};
+    }
+
+    uint64_t result = 0;
+
+    switch (mode)
+    {
+        case libcrypt::pow_mode::binary:
+            result = libcrypt::binary_pow(mont_base, exp, ctx);
+            break;
+        case libcrypt::pow_mode::sliding_window:
+            result = libcrypt::sliding_window_pow(mont_base, exp, ctx);
+            break;
+        case libcrypt::pow_mode::constant_time:
+            result = libcrypt::constant_time_pow(mont_base, exp, ctx);
+            break;
+    }
+
+    const int64_t value = ctx.from_form(result);
+    return negate ? -value : value;
+}
+
+int64_t multi_pow_mod(std::span<const int64_t> bases, std::span<const int64_t> exps, int64_t mod)
+{
+    if (mod > 1 && (mod & 1))
+    {
+        return libcrypt::multi_pow_mod(bases, exps, libcrypt::MontgomeryContext(mod));
+    }
+
+    if (bases.size() != exps.size())
+    {
+        throw std::runtime_error{"Number of bases and exponents must match"};
+    }
+
+    int64_t result = libcrypt::mod(1, mod);
+    for (size_t i = 0; i < bases.size(); i++)
+    {
+        result = libcrypt::mulmod(result, libcrypt::pow_mod(libcrypt::mod(bases[i], mod), exps[i], mod), mod);
+    }
+    return result;
+}
+
+int64_t multi_pow_mod(
+    std::span<const int64_t> bases,
+    std::span<const int64_t> exps,
+    const libcrypt::MontgomeryContext& ctx)
+{
+    if (bases.size() != exps.size())
+    {
+        throw std::runtime_error{"Number of bases and exponents must match"};
+    }
+
+    if (bases.size() > libcrypt::multi_pow_max_bases)
+    {
+        throw std::runtime_error{"Too many bases for multi_pow_mod"};
+    }
+
+    // table[mask] is the product of the bases selected by mask
+    std::array<uint64_t, 1 << libcrypt::multi_pow_max_bases> table{};
+    table[0] = ctx.one();
+
+    uint64_t max_exp = 0;
+    for (size_t i = 0; i < bases.size(); i++)
+    {
+        if (exps[i] < 0)
+        {
+            throw std::runtime_error{"Exponent must be non-negative"};
+        }
+
+        const size_t bit = size_t{1} << i;
+        const uint64_t mont_base = ctx.to_form(bases[i]);
+
+        for (size_t mask = 0; mask < bit; mask++)
+        {
+            table[bit | mask] = ctx.mul(table[mask], mont_base);
+        }
+
+        max_exp |= static_cast<uint64_t>(exps[i]);
+    }
+
+    uint64_t result = ctx.one();
+
+    for (int bit = std::bit_width(max_exp) - 1; bit >= 0; bit--)
+    {
+        result = ctx.mul(result, result);
+
+        size_t mask = 0;
+        for (size_t i = 0; i < exps.size(); i++)
+        {
+            mask |= ((static_cast<uint64_t>(exps[i]) >> bit) & 1) << i;
+        }
+
+        if (mask)
+        {
+            result = ctx.mul(result, table[mask]);
+        }
+    }
+
+    return ctx.from_form(result);
+}
+
+libcrypt::gcd_result xgcd(int64_t first, int64_t second)
+{
+    libcrypt::gcd_result u{first, 1, 0};
+    libcrypt::gcd_result v{second, 0, 1};
+
+    while (v.gcd != 0)
+    {
+        const int64_t q = u.gcd / v.gcd;
+        const libcrypt::gcd_result t{u.gcd % v.gcd, u.x - q * v.x, u.y - q * v.y};
+        u = v;
+        v = t;
     }
+
+    return u;
 }
 
 std::vector<int64_t> extended_gcd(int64_t first, int64_t second)
@@ -39,32 +283,116 @@ std::vector<int64_t> extended_gcd(int64_t first, int64_t second)
         std::swap(first, second);
     }
 
-    std::vector<int64_t> u{first, 1, 0};
-    std::vector<int64_t> v{second, 0, 1};
+    const libcrypt::gcd_result result = libcrypt::xgcd(first, second);
+
+    return {result.gcd, result.x, result.y};
+}
 
-    while (v.front() != 0)
+int64_t binary_gcd(int64_t first, int64_t second)
+{
+    uint64_t u = (first < 0) ? -static_cast<uint64_t>(first) : static_cast<uint64_t>(first);
+    uint64_t v = (second < 0) ? -static_cast<uint64_t>(second) : static_cast<uint64_t>(second);
+
+    if (u == 0 || v == 0)
     {
-        int64_t q = u.front() / v.front();
-        std::vector<int64_t> t{u.front() % v.front(), u.at(1) - q * v.at(1), u.back() - q * v.back()};
-        u = std::move(v);
-        v = std::move(t);
+        return static_cast<int64_t>(u | v);
     }
 
-    return u;
+    const int shift = std::countr_zero(u | v);
+    u >>= std::countr_zero(u);
+
+    while (v != 0)
+    {
+        v >>= std::countr_zero(v);
+
+        if (u > v)
+        {
+            std::swap(u, v);
+        }
+
+        v -= u;
+    }
+
+    return static_cast<int64_t>(u << shift);
 }
 
-bool is_prime(int64_t prime)
+int64_t inverse_mod(int64_t value, int64_t mod)
 {
-    if (prime <= 1)
+    const libcrypt::gcd_result result = libcrypt::xgcd(libcrypt::mod(value, mod), mod);
+
+    if (result.gcd != 1)
     {
-        return false;
+        return -1;
     }
 
-    auto b = static_cast<int64_t>(std::sqrt(prime));
+    return libcrypt::mod(result.x, mod);
+}
 
-    for (int64_t i = 2; i <= b; ++i)
+void batch_inverse_mod(std::span<const int64_t> values, std::span<int64_t> inverses, int64_t mod)
+{
+    if (inverses.size() < values.size())
     {
-        if ((prime % i) == 0)
+        throw std::runtime_error{"Not enough space for inverses"};
+    }
+
+    if (values.empty())
+    {
+        return;
+    }
+
+    int64_t product = libcrypt::mod(1, mod);
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        product = libcrypt::mulmod(product, libcrypt::mod(values[i], mod), mod);
+        inverses[i] = product;
+    }
+
+    int64_t inverse = libcrypt::inverse_mod(product, mod);
+
+    if (inverse < 0)
+    {
+        throw std::runtime_error{"Value is not invertible"};
+    }
+
+    for (size_t i = values.size() - 1; i > 0; i--)
+    {
+        inverses[i] = libcrypt::mulmod(inverse, inverses[i - 1], mod);
+        inverse = libcrypt::mulmod(inverse, libcrypt::mod(values[i], mod), mod);
+    }
+
+    inverses[0] = inverse;
+}
+
+// deterministic for every 64-bit input with the first twelve primes as witnesses
+static bool miller_rabin(int64_t prime)
+{
+    constexpr std::array<int64_t, 12> witnesses{2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+    const libcrypt::MontgomeryContext ctx(prime);
+    const uint64_t minus_one = ctx.to_form(prime - 1);
+
+    const int trailing_zeros = std::countr_zero(static_cast<uint64_t>(prime - 1));
+    const int64_t odd_part = (prime - 1) >> trailing_zeros;
+
+    for (const int64_t witness : witnesses)
+    {
+        uint64_t x = ctx.to_form(libcrypt::pow_mod(witness, odd_part, ctx));
+
+        if (x == ctx.one() || x == minus_one)
+        {
+            continue;
+        }
+
+        bool composite = true;
+
+        for (int i = 1; i < trailing_zeros && composite; i++)
+        {
+            x = ctx.mul(x, x);
+            composite = (x != minus_one);
+        }
+
+        if (composite)
         {
             return false;
         }
@@ -73,36 +401,127 @@ bool is_prime(int64_t prime)
     return true;
 }
 
-int64_t gen_germain_prime()
+bool is_prime(int64_t prime)
 {
-    int64_t germain_prime = 0;
-    std::random_device rd;
-    std::mt19937 mt(rd());
-    std::uniform_int_distribution<int64_t> prime_range(INT16_MAX, INT32_MAX / 2 - 1);
+    constexpr std::array<int64_t, 15> small_primes{2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
+    constexpr int64_t trial_division_limit = 53 * 53;
 
-    do
+    if (prime <= 1)
     {
-        germain_prime = prime_range(mt);
-    } while (!is_prime(germain_prime) || !is_prime(2 * germain_prime + 1));
+        return false;
+    }
 
-    return germain_prime;
+    for (const int64_t small_prime : small_primes)
+    {
+        if ((prime % small_prime) == 0)
+        {
+            return prime == small_prime;
+        }
+    }
+
+    if (prime < trial_division_limit)
+    {
+        return true;
+    }
+
+    return libcrypt::miller_rabin(prime);
 }
 
-libcrypt::dh_system_params gen_dh_system()
+static const std::vector<int64_t>& sieve_primes()
+{
+    constexpr int64_t sieve_limit = 2048;
+
+    static const std::vector<int64_t> primes = [] {
+        std::vector<bool> composite(sieve_limit, false);
+        std::vector<int64_t> odd_primes;
+
+        for (int64_t i = 3; i < sieve_limit; i += 2)
+        {
+            if (composite[i])
+            {
+                continue;
+            }
+
+            odd_primes.emplace_back(i);
+
+            for (int64_t j = i * i; j < sieve_limit; j += 2 * i)
+            {
+                composite[j] = true;
+            }
+        }
+
+        return odd_primes;
+    }();
+
+    return primes;
+}
+
+// candidates q whose q or 2q+1 has a factor below the sieve limit are crossed out before any primality test;
+// window_start must exceed the sieve limit
+static int64_t find_germain_prime_in_window(int64_t window_start, int64_t window_size)
+{
+    std::vector<bool> crossed_out(window_size, false);
+
+    for (int64_t i = window_start & 1; i < window_size; i += 2)
+    {
+        crossed_out[i] = true;
+    }
+
+    for (const int64_t sieve_prime : libcrypt::sieve_primes())
+    {
+        // q = 0 (mod p) makes q composite, q = (p - 1) / 2 (mod p) makes 2q + 1 composite
+        for (const int64_t residue : {int64_t{0}, (sieve_prime - 1) / 2})
+        {
+            for (int64_t i = libcrypt::mod(residue - window_start, sieve_prime); i < window_size; i += sieve_prime)
+            {
+                crossed_out[i] = true;
+            }
+        }
+    }
+
+    for (int64_t i = 0; i < window_size; i++)
+    {
+        const int64_t candidate = window_start + i;
+
+        if (!crossed_out[i] && is_prime(candidate) && is_prime(2 * candidate + 1))
+        {
+            return candidate;
+        }
+    }
+
+    return -1;
+}
+
+int64_t gen_germain_prime(unsigned threads_num)
+{
+    constexpr int64_t min_prime = INT16_MAX;
+    constexpr int64_t max_prime = INT32_MAX / 2 - 1;
+    constexpr int64_t window_size = 4096;
+
+    return libcrypt::parallel_search(
+        [](std::mt19937& mt) {
+            std::uniform_int_distribution<int64_t> window_range(min_prime, max_prime - window_size + 1);
+            return libcrypt::find_germain_prime_in_window(window_range(mt), window_size);
+        },
+        threads_num);
+}
+
+libcrypt::dh_system_params gen_dh_system(unsigned threads_num)
 {
     int64_t base = 0;
     std::random_device rd;
     std::mt19937 mt(rd());
 
-    int64_t germain_prime = gen_germain_prime();
+    int64_t germain_prime = gen_germain_prime(threads_num);
     int64_t mod = 2 * germain_prime + 1;
+    const libcrypt::MontgomeryContext ctx(mod);
 
     std::uniform_int_distribution<int64_t> base_range(2, germain_prime - 2);
 
     do
     {
         base = base_range(mt);
-    } while (pow_mod(base, germain_prime, mod) == 1);
+    } while (pow_mod(base, germain_prime, ctx) == 1);
 
     return libcrypt::dh_system_params{base, mod};
 }
@@ -122,12 +541,18 @@ int64_t diffie_hellman(int64_t private_keyA, int64_t private_keyB)
 
 int64_t baby_step_giant_step(int64_t base, int64_t result, int64_t mod)
 {
-    int64_t giant_step = std::ceil(std::sqrt(mod));
+    auto giant_step = static_cast<int64_t>(std::ceil(std::sqrt(static_cast<double>(mod))));
+
+    while (static_cast<libcrypt::int128_t>(giant_step) * giant_step < mod)
+    {
+        giant_step++;
+    }
+
     int64_t base_pow_gstep = 1;
 
     for (int64_t i = 0; i < giant_step; i++)
     {
-        base_pow_gstep = (base_pow_gstep * base) % mod;
+        base_pow_gstep = libcrypt::mulmod(base_pow_gstep, base, mod);
     }
 
     std::unordered_map<int64_t, int64_t> giant_step_table;
@@ -135,7 +560,7 @@ int64_t baby_step_giant_step(int64_t base, int64_t result, int64_t mod)
     for (int64_t i = 1, cur = base_pow_gstep; i <= giant_step; i++)
     {
         giant_step_table[cur] = i;
-        cur = (cur * base_pow_gstep) % mod;
+        cur = libcrypt::mulmod(cur, base_pow_gstep, mod);
     }
 
     for (int64_t j = 0, cur = result; j <= giant_step; j++)
@@ -145,7 +570,7 @@ int64_t baby_step_giant_step(int64_t base, int64_t result, int64_t mod)
             return giant_step_table.at(cur) * giant_step - j;
         }
 
-        cur = (cur * base) % mod;
+        cur = libcrypt::mulmod(cur, base, mod);
     }
 
     return -1;
@@ -0,0 +1,110 @@
+#include <libcrypt/xor_kernel.hpp>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <span>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LIBCRYPT_XOR_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace libcrypt {
+
+using xor_kernel = void (*)(const char* first, const char* second, char* result, std::size_t size);
+
+static void xor_scalar(const char* first, const char* second, char* result, std::size_t size)
+{
+    std::size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t first_word = 0;
+        uint64_t second_word = 0;
+        std::memcpy(&first_word, first + i, sizeof(uint64_t));
+        std::memcpy(&second_word, second + i, sizeof(uint64_t));
+        first_word ^= second_word;
+        std::memcpy(result + i, &first_word, sizeof(uint64_t));
+    }
+
+    for (; i < size; i++)
+    {
+        result[i] = static_cast<char>(first[i] ^ second[i]);
+    }
+}
+
+#ifdef LIBCRYPT_XOR_DISPATCH
+
+__attribute__((target("avx2"))) static void xor_avx2(
+    const char* first,
+    const char* second,
+    char* result,
+    std::size_t size)
+{
+    constexpr std::size_t lane = sizeof(__m256i);
+    std::size_t i = 0;
+
+    for (; i + lane <= size; i += lane)
+    {
+        const __m256i first_lane = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+        const __m256i second_lane = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_xor_si256(first_lane, second_lane));
+    }
+
+    libcrypt::xor_scalar(first + i, second + i, result + i, size - i);
+}
+
+__attribute__((target("avx512f"))) static void xor_avx512(
+    const char* first,
+    const char* second,
+    char* result,
+    std::size_t size)
+{
+    constexpr std::size_t lane = sizeof(__m512i);
+    std::size_t i = 0;
+
+    for (; i + lane <= size; i += lane)
+    {
+        const __m512i first_lane = _mm512_loadu_si512(first + i);
+        const __m512i second_lane = _mm512_loadu_si512(second + i);
+        _mm512_storeu_si512(result + i, _mm512_xor_si512(first_lane, second_lane));
+    }
+
+    libcrypt::xor_scalar(first + i, second + i, result + i, size - i);
+}
+
+#endif
+
+static xor_kernel select_xor_kernel()
+{
+#ifdef LIBCRYPT_XOR_DISPATCH
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return libcrypt::xor_avx512;
+    }
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return libcrypt::xor_avx2;
+    }
+#endif
+
+    return libcrypt::xor_scalar;
+}
+
+void xor_bytes(std::span<const char> first, std::span<const char> second, std::span<char> result)
+{
+    static const xor_kernel kernel = libcrypt::select_xor_kernel();
+
+    if (second.size() < first.size() || result.size() < first.size())
+    {
+        throw std::runtime_error{"xor operands are shorter than the first one"};
+    }
+
+    kernel(first.data(), second.data(), result.data(), first.size());
+}
+
+}  // namespace libcrypt
@@ -1,8 +1,15 @@
 #include <libcrypt/utils.hpp>
 #include <libcrypt/ciphers.hpp>
+#include <libcrypt/xor_kernel.hpp>
+#include <libcrypt/packed_format.hpp>
+#include <libcrypt/byte_stream.hpp>
+#include <libcrypt/mapped_file.hpp>
 #include <params/gen_params.hpp>
 #include <PicoSHA2/picosha2.h>
 #include <gtest/gtest.h>
+#include <array>
+#include <functional>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -95,6 +102,52 @@ class CiphersTest : public testing::Test
         std::filesystem::remove(temp_dir + "/medium.txt");
         std::filesystem::remove(temp_dir + "/big.txt");
     }
+
+    void check_round_trip(
+        const std::function<void(std::ifstream&, std::fstream&)>& encrypt,
+        const std::function<void(std::fstream&, std::ofstream&)>& decrypt,
+        std::uintmax_t max_size_ratio)
+    {
+        for (auto& file : files)
+        {
+            std::fstream encryption_file(
+                temp_dir + "/round_trip_e.txt", std::ios::binary | std::ios::out | std::ios::in | std::ios::trunc);
+
+            std::ofstream decryption_file_out(temp_dir + "/round_trip_d.txt", std::ios::binary);
+
+            if (!file.is_open() || !encryption_file.is_open() || !decryption_file_out.is_open())
+            {
+                throw std::runtime_error{"Can't open file in cipher round trip test"};
+            }
+
+            encrypt(file, encryption_file);
+            encryption_file.flush();
+
+            encryption_file.clear();
+            encryption_file.seekg(std::ios::beg);
+
+            decrypt(encryption_file, decryption_file_out);
+
+            decryption_file_out.close();
+
+            std::ifstream decryption_file_in(temp_dir + "/round_trip_d.txt", std::ios::binary);
+
+            file.clear();
+            file.seekg(std::ios::beg);
+
+            EXPECT_LE(
+                std::filesystem::file_size(temp_dir + "/round_trip_e.txt"),
+                max_size_ratio * std::filesystem::file_size(temp_dir + "/round_trip_d.txt") + 64);
+
+            ASSERT_EQ(calc_file_hash(file), calc_file_hash(decryption_file_in));
+
+            file.close();
+            encryption_file.close();
+            decryption_file_in.close();
+            std::filesystem::remove(temp_dir + "/round_trip_e.txt");
+            std::filesystem::remove(temp_dir + "/round_trip_d.txt");
+        }
+    }
 };
 
 TEST_F(CiphersTest, shamir_with_different_files_size)
@@ -261,6 +314,79 @@ TEST_F(CiphersTest, vernam_with_different_files_size)
     }
 }
 
+TEST_F(CiphersTest, vernam_mapped_with_different_files_size)
+{
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<int16_t> randomizer(CHAR_MIN, CHAR_MAX);
+
+    std::ofstream vernam_key_file(temp_dir + "/vernam_key.txt", std::ios::binary);
+
+    if (!vernam_key_file.is_open())
+    {
+        throw std::runtime_error{"Can't open file in vernam's mapped cipher test"};
+    }
+
+    for (uintmax_t i = 0; i < vernam_key_max_size; i++)
+    {
+        char rand = static_cast<char>(randomizer(mt));
+        vernam_key_file.write(reinterpret_cast<const char*>(&rand), sizeof(char));
+    }
+
+    vernam_key_file.close();
+
+    for (const std::string name : {"/small.txt", "/medium.txt", "/big.txt"})
+    {
+        libcrypt::vernam_encrypt_mapped(temp_dir + "/vernam_key.txt", temp_dir + name, temp_dir + "/vernam_e.txt");
+        libcrypt::vernam_decrypt_mapped(
+            temp_dir + "/vernam_key.txt", temp_dir + "/vernam_e.txt", temp_dir + "/vernam_d.txt");
+
+        std::ifstream message_file(temp_dir + name, std::ios::binary);
+        std::ifstream decryption_file_in(temp_dir + "/vernam_d.txt", std::ios::binary);
+
+        if (!message_file.is_open() || !decryption_file_in.is_open())
+        {
+            throw std::runtime_error{"Can't open file in vernam's mapped cipher test"};
+        }
+
+        std::string message_hash{calc_file_hash(message_file)};
+        std::string decrypted_hash{calc_file_hash(decryption_file_in)};
+
+        ASSERT_EQ(message_hash, decrypted_hash);
+    }
+
+    const auto encrypted_perms = std::filesystem::perms::owner_read | std::filesystem::perms::owner_write
+                               | std::filesystem::perms::group_read;
+    std::filesystem::permissions(temp_dir + "/vernam_e.txt", encrypted_perms);
+    libcrypt::vernam_encrypt_mapped(temp_dir + "/vernam_key.txt", temp_dir + "/small.txt", temp_dir + "/vernam_e.txt");
+    ASSERT_EQ(std::filesystem::status(temp_dir + "/vernam_e.txt").permissions(), encrypted_perms);
+
+    const std::uintmax_t encrypted_size = std::filesystem::file_size(temp_dir + "/vernam_e.txt");
+    const std::uintmax_t message_size = std::filesystem::file_size(temp_dir + "/small.txt");
+
+    ASSERT_ANY_THROW(libcrypt::vernam_encrypt_mapped(
+        temp_dir + "/vernam_key.txt", temp_dir + "/small.txt", temp_dir + "/small.txt"));
+    ASSERT_EQ(std::filesystem::file_size(temp_dir + "/small.txt"), message_size);
+
+    std::filesystem::resize_file(temp_dir + "/vernam_key.txt", 1);
+
+    ASSERT_ANY_THROW(libcrypt::vernam_encrypt_mapped(
+        temp_dir + "/vernam_key.txt", temp_dir + "/small.txt", temp_dir + "/vernam_e.txt"));
+    ASSERT_EQ(std::filesystem::file_size(temp_dir + "/vernam_e.txt"), encrypted_size);
+
+    for (const auto& entry : std::filesystem::directory_iterator(temp_dir))
+    {
+        ASSERT_FALSE(entry.path().filename().string().starts_with("vernam_e.txt."));
+    }
+
+    const libcrypt::FileDescriptor device_fd("/dev/null", libcrypt::open_mode::read);
+    ASSERT_ANY_THROW(libcrypt::MappedFile{device_fd.get()});
+
+    std::filesystem::remove(temp_dir + "/vernam_key.txt");
+    std::filesystem::remove(temp_dir + "/vernam_e.txt");
+    std::filesystem::remove(temp_dir + "/vernam_d.txt");
+}
+
 TEST_F(CiphersTest, rsa_with_different_files_size)
 {
     libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
@@ -309,4 +435,443 @@ TEST_F(CiphersTest, rsa_with_different_files_size)
     }
 }
 
+TEST_F(CiphersTest, rsa_crt_with_different_files_size)
+{
+    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+
+    for (auto& file : files)
+    {
+        std::fstream encryption_file(
+            temp_dir + "/rsa_e.txt", std::ios::binary | std::ios::out | std::ios::in | std::ios::trunc);
+
+        std::ofstream decryption_file_out(temp_dir + "/rsa_d.txt", std::ios::binary);
+
+        if (!file.is_open() || !encryption_file.is_open() || !decryption_file_out.is_open())
+        {
+            throw std::runtime_error{"Can't open file in rsa cipher test"};
+        }
+
+        libcrypt::rsa_encrypt(params.mod, params.user.shared_key, file, encryption_file);
+
+        encryption_file.clear();
+        encryption_file.seekp(std::ios::beg);
+
+        libcrypt::rsa_decrypt(params.private_key, encryption_file, decryption_file_out);
+
+        decryption_file_out.close();
+
+        std::ifstream decryption_file_in(temp_dir + "/rsa_d.txt", std::ios::binary);
+
+        if (!decryption_file_in.is_open())
+        {
+            throw std::runtime_error{"Can't open file in rsa cipher test"};
+        }
+
+        file.clear();
+        file.seekg(std::ios::beg);
+
+        std::string message_hash{calc_file_hash(file)};
+        std::string decrypted_hash{calc_file_hash(decryption_file_in)};
+
+        ASSERT_EQ(message_hash, decrypted_hash);
+
+        file.close();
+        encryption_file.close();
+        decryption_file_in.close();
+        std::filesystem::remove(temp_dir + "/rsa_e.txt");
+        std::filesystem::remove(temp_dir + "/rsa_d.txt");
+    }
+}
+
+TEST_F(CiphersTest, shamir_packed_with_different_files_size)
+{
+    libcrypt::shamir_sys_params params = libcrypt::shamir_gen_sys();
+
+    check_round_trip(
+        [&](std::ifstream& message_file, std::fstream& encrypt_file) {
+            libcrypt::shamir_encrypt_packed(
+                params.mod, params.recv.private_key, params.send.private_key, message_file, encrypt_file);
+        },
+        [&](std::fstream& encrypt_file, std::ofstream& decrypt_file) {
+            libcrypt::shamir_decrypt_packed(
+                params.mod, params.recv.shared_key, params.send.shared_key, encrypt_file, decrypt_file);
+        },
+        2);
+}
+
+TEST_F(CiphersTest, elgamal_packed_with_different_files_size)
+{
+    libcrypt::elgamal_sys_params params = libcrypt::elgamal_gen_sys();
+
+    check_round_trip(
+        [&](std::ifstream& message_file, std::fstream& encrypt_file) {
+            libcrypt::elgamal_encrypt_packed(
+                params.dh_sys_params, params.session_key, params.user.shared_key, message_file, encrypt_file);
+        },
+        [&](std::fstream& encrypt_file, std::ofstream& decrypt_file) {
+            libcrypt::elgamal_decrypt_packed(
+                params.dh_sys_params.mod, params.user.private_key, encrypt_file, decrypt_file);
+        },
+        2);
+}
+
+TEST_F(CiphersTest, rsa_packed_with_different_files_size)
+{
+    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+
+    check_round_trip(
+        [&](std::ifstream& message_file, std::fstream& encrypt_file) {
+            libcrypt::rsa_encrypt_packed(params.mod, params.user.shared_key, message_file, encrypt_file);
+        },
+        [&](std::fstream& encrypt_file, std::ofstream& decrypt_file) {
+            libcrypt::rsa_decrypt_packed(params.private_key, encrypt_file, decrypt_file);
+        },
+        2);
+}
+
+TEST_F(CiphersTest, rsa_parallel_with_different_files_size)
+{
+    const libcrypt::cipher_options options{4, 4096};
+    libcrypt::rsa_sys_params rsa_params = libcrypt::rsa_gen_sys();
+
+    check_round_trip(
+        [&](std::ifstream& message_file, std::fstream& encrypt_file) {
+            libcrypt::rsa_encrypt(rsa_params.mod, rsa_params.user.shared_key, message_file, encrypt_file, options);
+        },
+        [&](std::fstream& encrypt_file, std::ofstream& decrypt_file) {
+            libcrypt::rsa_decrypt(rsa_params.private_key, encrypt_file, decrypt_file, options);
+        },
+        sizeof(int32_t));
+}
+
+TEST_F(CiphersTest, shamir_parallel_with_different_files_size)
+{
+    const libcrypt::cipher_options options{4, 4096};
+    libcrypt::shamir_sys_params params = libcrypt::shamir_gen_sys();
+
+    check_round_trip(
+        [&](std::ifstream& message_file, std::fstream& encrypt_file) {
+            libcrypt::shamir_encrypt(
+                params.mod, params.recv.private_key, params.send.private_key, message_file, encrypt_file, options);
+        },
+        [&](std::fstream& encrypt_file, std::ofstream& decrypt_file) {
+            libcrypt::shamir_decrypt(
+                params.mod, params.recv.shared_key, params.send.shared_key, encrypt_file, decrypt_file, options);
+        },
+        sizeof(int32_t));
+}
+
+TEST_F(CiphersTest, vernam_parallel_with_different_files_size)
+{
+    const libcrypt::cipher_options options{4, 4096};
+
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<int16_t> randomizer(CHAR_MIN, CHAR_MAX);
+
+    std::ofstream vernam_key_out(temp_dir + "/vernam_key.txt", std::ios::binary);
+
+    if (!vernam_key_out.is_open())
+    {
+        throw std::runtime_error{"Can't open file in vernam's parallel cipher test"};
+    }
+
+    for (uintmax_t i = 0; i < vernam_key_max_size; i++)
+    {
+        char rand = static_cast<char>(randomizer(mt));
+        vernam_key_out.write(reinterpret_cast<const char*>(&rand), sizeof(char));
+    }
+
+    vernam_key_out.close();
+
+    std::fstream vernam_key_file(temp_dir + "/vernam_key.txt", std::ios::binary | std::ios::in | std::ios::out);
+
+    if (!vernam_key_file.is_open())
+    {
+        throw std::runtime_error{"Can't open file in vernam's parallel cipher test"};
+    }
+
+    const auto rewind_key = [&] {
+        vernam_key_file.clear();
+        vernam_key_file.seekg(std::ios::beg);
+    };
+
+    check_round_trip(
+        [&](std::ifstream& message_file, std::fstream& encrypt_file) {
+            rewind_key();
+            libcrypt::vernam_encrypt(vernam_key_file, message_file, encrypt_file, options);
+        },
+        [&](std::fstream& encrypt_file, std::ofstream& decrypt_file) {
+            rewind_key();
+            libcrypt::vernam_decrypt(vernam_key_file, encrypt_file, decrypt_file, options);
+        },
+        1);
+
+    vernam_key_file.close();
+
+    // a key shorter than the message must be rejected even when the chunks are spread over workers
+    std::filesystem::resize_file(temp_dir + "/vernam_key.txt", 4096 * 3 + 1);
+
+    std::fstream short_key_file(temp_dir + "/vernam_key.txt", std::ios::binary | std::ios::in | std::ios::out);
+    std::ifstream message_file(temp_dir + "/big.txt", std::ios::binary);
+    std::fstream encryption_file(
+        temp_dir + "/vernam_e.txt", std::ios::binary | std::ios::out | std::ios::in | std::ios::trunc);
+
+    if (!short_key_file.is_open() || !message_file.is_open() || !encryption_file.is_open())
+    {
+        throw std::runtime_error{"Can't open file in vernam's parallel cipher test"};
+    }
+
+    ASSERT_ANY_THROW(libcrypt::vernam_encrypt(short_key_file, message_file, encryption_file, options));
+
+    short_key_file.close();
+    message_file.close();
+    encryption_file.close();
+    std::filesystem::remove(temp_dir + "/vernam_key.txt");
+    std::filesystem::remove(temp_dir + "/vernam_e.txt");
+}
+
+TEST_F(CiphersTest, elgamal_parallel_with_different_files_size)
+{
+    const libcrypt::cipher_options options{4, 4096};
+    libcrypt::elgamal_sys_params elgamal_params = libcrypt::elgamal_gen_sys();
+
+    check_round_trip(
+        [&](std::ifstream& message_file, std::fstream& encrypt_file) {
+            libcrypt::elgamal_encrypt(
+                elgamal_params.dh_sys_params,
+                elgamal_params.session_key,
+                elgamal_params.user.shared_key,
+                message_file,
+                encrypt_file,
+                options);
+        },
+        [&](std::fstream& encrypt_file, std::ofstream& decrypt_file) {
+            libcrypt::elgamal_decrypt(
+                elgamal_params.dh_sys_params.mod, elgamal_params.user.private_key, encrypt_file, decrypt_file, options);
+        },
+        sizeof(int32_t));
+}
+
+TEST_F(CiphersTest, rsa_file_backend_with_different_files_size)
+{
+    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+
+    for (const unsigned queue_depth : {4U, 0U})
+    {
+        for (const std::string name : {"/small.txt", "/medium.txt", "/big.txt"})
+        {
+            {
+                const libcrypt::FileDescriptor message_fd(temp_dir + name, libcrypt::open_mode::read);
+                const libcrypt::FileDescriptor encrypt_fd(temp_dir + "/rsa_e.txt", libcrypt::open_mode::write);
+
+                libcrypt::FileSource message(message_fd.get(), 4096, queue_depth);
+                libcrypt::FileSink encrypted(encrypt_fd.get(), 4096, queue_depth);
+
+                libcrypt::rsa_encrypt(params.mod, params.user.shared_key, message, encrypted, {2, 4096, true});
+            }
+
+            {
+                const libcrypt::FileDescriptor encrypt_fd(temp_dir + "/rsa_e.txt", libcrypt::open_mode::read);
+                const libcrypt::FileDescriptor decrypt_fd(temp_dir + "/rsa_d.txt", libcrypt::open_mode::write);
+
+                libcrypt::FileSource encrypted(encrypt_fd.get(), 4096, queue_depth);
+                libcrypt::FileSink decrypted(decrypt_fd.get(), 4096, queue_depth);
+
+                libcrypt::rsa_decrypt(params.private_key, encrypted, decrypted);
+            }
+
+            std::ifstream message_file(temp_dir + name, std::ios::binary);
+            std::ifstream decryption_file_in(temp_dir + "/rsa_d.txt", std::ios::binary);
+
+            if (!message_file.is_open() || !decryption_file_in.is_open())
+            {
+                throw std::runtime_error{"Can't open file in rsa's file backend test"};
+            }
+
+            ASSERT_EQ(
+                std::filesystem::file_size(temp_dir + "/rsa_e.txt"),
+                sizeof(int32_t) * std::filesystem::file_size(temp_dir + name));
+            ASSERT_EQ(calc_file_hash(message_file), calc_file_hash(decryption_file_in));
+        }
+    }
+
+    std::filesystem::remove(temp_dir + "/rsa_e.txt");
+    std::filesystem::remove(temp_dir + "/rsa_d.txt");
+}
+
+TEST(byte_stream, file_odd_sizes_round_trip)
+{
+    const std::string path = std::filesystem::temp_directory_path().string() + "/byte_stream.txt";
+
+    std::mt19937 mt(42);
+    std::uniform_int_distribution<int16_t> randomizer(CHAR_MIN, CHAR_MAX);
+    std::uniform_int_distribution<std::size_t> sizes(0, 2500);
+    const bool expect_async = libcrypt::io_uring_supported();
+
+    std::vector<char> data(100000);
+    for (auto& byte : data)
+    {
+        byte = static_cast<char>(randomizer(mt));
+    }
+
+    for (const unsigned queue_depth : {3U, 0U})
+    {
+        {
+            const libcrypt::FileDescriptor fd(path, libcrypt::open_mode::write);
+            libcrypt::FileSink sink(fd.get(), 1000, queue_depth);
+            EXPECT_EQ(sink.is_async(), expect_async && queue_depth > 0);
+
+            for (std::size_t written = 0; written < data.size();)
+            {
+                const std::size_t count = std::min(sizes(mt), data.size() - written);
+                sink.write(std::span<const char>{data}.subspan(written, count));
+                written += count;
+            }
+
+            sink.flush();
+        }
+
+        const libcrypt::FileDescriptor fd(path, libcrypt::open_mode::read);
+        libcrypt::FileSource source(fd.get(), 1000, queue_depth);
+        EXPECT_EQ(source.is_async(), expect_async && queue_depth > 0);
+
+        std::vector<char> read;
+        std::vector<char> buffer(2500);
+
+        // reads of 1 to buffer.size() bytes
+        for (std::size_t count = source.read(std::span<char>{buffer}.first(sizes(mt) % buffer.size() + 1)); count > 0;
+             count = source.read(std::span<char>{buffer}.first(sizes(mt) % buffer.size() + 1)))
+        {
+            read.insert(read.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+
+        ASSERT_EQ(read, data) << queue_depth;
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(packed_format, bits_round_trip)
+{
+    constexpr std::array<int, 6> widths{1, 7, 9, 17, 31, 63};
+    std::stringstream packed;
+
+    {
+        libcrypt::BitWriter writer(packed);
+        for (int i = 0; i < 100; i++)
+        {
+            const int bits = widths.at(i % widths.size());
+            writer.write(static_cast<uint64_t>(i) * 2654435761U, bits);
+        }
+    }
+
+    libcrypt::BitReader reader(packed);
+    for (int i = 0; i < 100; i++)
+    {
+        const int bits = widths.at(i % widths.size());
+        const uint64_t expected = (static_cast<uint64_t>(i) * 2654435761U) & ((uint64_t{1} << bits) - 1);
+        EXPECT_EQ(reader.read(bits), expected) << i;
+    }
+
+    EXPECT_ANY_THROW(reader.read(8));
+}
+
+TEST(packed_format, header_is_little_endian)
+{
+    std::stringstream message("message");
+    std::stringstream packed;
+
+    libcrypt::write_packed_header(
+        packed, libcrypt::make_packed_header(libcrypt::packed_algorithm::rsa, 1000003, message, -2));
+
+    std::string expected{"LCPK"};
+    expected += static_cast<char>(libcrypt::packed_version);
+    expected += static_cast<char>(libcrypt::packed_algorithm::rsa);
+    expected += {20, 2, 7, 0, 0, 0, 0, 0, 0, 0};
+    expected += std::string(1, '\xfe') + std::string(7, '\xff');
+
+    EXPECT_EQ(packed.str(), expected);
+    EXPECT_EQ(libcrypt::read_packed_header(packed, libcrypt::packed_algorithm::rsa, 1000003).ciphertext_first, -2);
+}
+
+TEST(packed_format, header_mismatch)
+{
+    std::stringstream message("message");
+    std::stringstream packed;
+
+    const libcrypt::packed_header header
+        = libcrypt::make_packed_header(libcrypt::packed_algorithm::rsa, 1000003, message);
+    EXPECT_EQ(header.message_size, 7);
+    EXPECT_EQ(header.bytes_per_block, 2);
+
+    libcrypt::write_packed_header(packed, header);
+
+    EXPECT_ANY_THROW(libcrypt::read_packed_header(packed, libcrypt::packed_algorithm::shamir, 1000003));
+    packed.seekg(0);
+    EXPECT_ANY_THROW(libcrypt::read_packed_header(packed, libcrypt::packed_algorithm::rsa, 3000017));
+    packed.seekg(0);
+    EXPECT_NO_THROW(libcrypt::read_packed_header(packed, libcrypt::packed_algorithm::rsa, 1000003));
+}
+
+TEST(elgamal_session, span_round_trip)
+{
+    libcrypt::elgamal_sys_params params = libcrypt::elgamal_gen_sys();
+
+    const libcrypt::ElgamalSession sender(params.dh_sys_params, params.session_key, params.user.shared_key);
+
+    std::vector<char> message;
+    for (int i = CHAR_MIN; i <= CHAR_MAX; i++)
+    {
+        message.emplace_back(static_cast<char>(i));
+    }
+
+    std::vector<int32_t> encrypted(message.size());
+    sender.encrypt(message, encrypted);
+
+    const libcrypt::ElgamalSession receiver(
+        params.dh_sys_params.mod, params.user.private_key, sender.get_ciphertext_first());
+
+    std::vector<char> decrypted(encrypted.size());
+    receiver.decrypt(encrypted, decrypted);
+
+    ASSERT_EQ(message, decrypted);
+
+    EXPECT_ANY_THROW(sender.decrypt(encrypted, decrypted));
+    EXPECT_ANY_THROW(receiver.encrypt(message, encrypted));
+    EXPECT_ANY_THROW(sender.decrypt(int64_t{5}));
+    EXPECT_ANY_THROW(receiver.encrypt(int64_t{5}));
+    EXPECT_ANY_THROW(sender.encrypt(message, std::span{encrypted}.first(encrypted.size() - 1)));
+    EXPECT_ANY_THROW(receiver.decrypt(encrypted, std::span{decrypted}.first(decrypted.size() - 1)));
+}
+
+TEST(xor_bytes, unaligned_lengths)
+{
+    constexpr std::size_t max_size = 300;
+
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<int16_t> randomizer(CHAR_MIN, CHAR_MAX);
+
+    std::vector<char> first(max_size + 1);
+    std::vector<char> second(max_size + 1);
+
+    for (std::size_t i = 0; i <= max_size; i++)
+    {
+        first[i] = static_cast<char>(randomizer(mt));
+        second[i] = static_cast<char>(randomizer(mt));
+    }
+
+    for (std::size_t size = 0; size < max_size; size++)
+    {
+        std::vector<char> real(size);
+        libcrypt::xor_bytes(std::span{first}.subspan(1, size), std::span{second}.first(size), real);
+
+        for (std::size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(real[i], static_cast<char>(first[i + 1] ^ second[i]));
+        }
+    }
+}
+
 }  // namespace
@@ -1,9 +1,12 @@
 #include <params/gen_params.hpp>
 #include <libcrypt/signatures.hpp>
 #include <libcrypt/blind_sign.hpp>
+#include <libcrypt/sha256.hpp>
 #include <PicoSHA2/picosha2.h>
 #include <gtest/gtest.h>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <filesystem>
 #include <fstream>
 #include <random>
@@ -14,6 +17,66 @@
 
 namespace {
 
+class Sha256Test : public testing::TestWithParam<libcrypt::sha256_backend>
+{
+   protected:
+    virtual void SetUp()
+    {
+        if (!libcrypt::is_sha256_backend_supported(GetParam()))
+        {
+            GTEST_SKIP() << "sha256 backend isn't supported by this cpu";
+        }
+    }
+};
+
+TEST_P(Sha256Test, known_vectors)
+{
+    const std::vector<std::pair<std::string, std::string>> vectors{
+        {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"}};
+
+    for (const auto& [message, expected] : vectors)
+    {
+        libcrypt::Sha256 hasher(GetParam());
+        hasher.update(message);
+        EXPECT_EQ(hasher.finish_hex(), expected);
+    }
+}
+
+TEST_P(Sha256Test, split_updates)
+{
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<int16_t> num_gen_range(CHAR_MIN, CHAR_MAX);
+
+    for (std::size_t size = 0; size < 300; size += 7)
+    {
+        std::string message;
+
+        for (std::size_t i = 0; i < size; i++)
+        {
+            message += static_cast<char>(num_gen_range(mt));
+        }
+
+        const std::string expected{picosha2::hash256_hex_string(message)};
+
+        libcrypt::Sha256 hasher(GetParam());
+        std::uniform_int_distribution<std::size_t> split_range(0, size);
+        const std::size_t split = split_range(mt);
+        hasher.update(std::string_view{message}.substr(0, split));
+        hasher.update(std::string_view{message}.substr(split));
+
+        ASSERT_EQ(hasher.finish_hex(), expected);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    backends,
+    Sha256Test,
+    testing::Values(libcrypt::sha256_backend::scalar, libcrypt::sha256_backend::sha_ni));
+
 class SignaturesTest : public testing::Test
 {
    protected:
@@ -80,6 +143,33 @@ class SignaturesTest : public testing::Test
         std::filesystem::remove(temp_dir + "/medium.txt");
         std::filesystem::remove(temp_dir + "/big.txt");
     }
+
+    // batch functions open files themselves; the last path doesn't exist
+    std::vector<std::filesystem::path> batch_paths()
+    {
+        for (auto& file : files)
+        {
+            file.close();
+        }
+
+        return {temp_dir + "/small.txt", temp_dir + "/medium.txt", temp_dir + "/big.txt", temp_dir + "/missing.txt"};
+    }
+
+    static void check_batch_results(
+        const std::vector<std::filesystem::path>& paths,
+        const std::vector<libcrypt::file_sign_result>& results)
+    {
+        ASSERT_EQ(results.size(), paths.size());
+
+        for (std::size_t i = 0; i + 1 < paths.size(); i++)
+        {
+            EXPECT_EQ(results[i].path, paths[i]);
+            EXPECT_TRUE(results[i].ok) << results[i].error;
+        }
+
+        EXPECT_FALSE(results.back().ok);
+        EXPECT_FALSE(results.back().error.empty());
+    }
 };
 
 TEST_F(SignaturesTest, rsa_with_different_files_size)
@@ -98,6 +188,45 @@ TEST_F(SignaturesTest, rsa_with_different_files_size)
     }
 }
 
+TEST_F(SignaturesTest, rsa_crt_with_different_files_size)
+{
+    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+
+    for (auto& file : files)
+    {
+        libcrypt::rsa_file_signing(params.private_key, file);
+
+        file.seekg(std::ios::beg);
+
+        ASSERT_TRUE(libcrypt::rsa_check_file_sign(params.mod, params.user.shared_key, file));
+
+        file.close();
+    }
+}
+
+TEST_F(SignaturesTest, rsa_tampered_file)
+{
+    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+
+    for (auto& file : files)
+    {
+        libcrypt::rsa_file_signing(params.mod, params.user.private_key, file);
+
+        file.seekg(std::ios::beg);
+        char first_byte = 0;
+        file.read(&first_byte, sizeof(first_byte));
+        first_byte = static_cast<char>(~first_byte);
+        file.seekp(std::ios::beg);
+        file.write(&first_byte, sizeof(first_byte));
+        file.seekg(std::ios::beg);
+
+        ASSERT_FALSE(libcrypt::rsa_check_file_sign(params.mod, params.user.shared_key, file));
+        ASSERT_FALSE(std::filesystem::exists("tmp.txt"));
+
+        file.close();
+    }
+}
+
 TEST_F(SignaturesTest, elgamal_with_different_files_size)
 {
     libcrypt::elgamal_sys_params params = libcrypt::elgamal_gen_sys();
@@ -132,6 +261,77 @@ TEST_F(SignaturesTest, gost_with_different_files_size)
     }
 }
 
+TEST_F(SignaturesTest, rsa_batch_with_different_files_size)
+{
+    const std::vector<std::filesystem::path> paths = batch_paths();
+    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+
+    check_batch_results(paths, libcrypt::rsa_files_signing(params.private_key, paths, 3));
+    check_batch_results(paths, libcrypt::rsa_check_files_sign(params.mod, params.user.shared_key, paths, 3));
+
+    std::fstream file(paths.front(), std::ios::binary | std::ios::in | std::ios::out);
+    char first_byte = 0;
+    file.read(&first_byte, sizeof(first_byte));
+    first_byte = static_cast<char>(~first_byte);
+    file.seekp(std::ios::beg);
+    file.write(&first_byte, sizeof(first_byte));
+    file.close();
+
+    const auto tampered = libcrypt::rsa_check_files_sign(params.mod, params.user.shared_key, paths, 3);
+    ASSERT_FALSE(tampered.front().ok);
+    ASSERT_TRUE(tampered.front().error.empty());
+    ASSERT_TRUE(tampered[1].ok);
+}
+
+TEST_F(SignaturesTest, elgamal_batch_with_different_files_size)
+{
+    const std::vector<std::filesystem::path> paths = batch_paths();
+    libcrypt::elgamal_sys_params params = libcrypt::elgamal_gen_sys();
+
+    check_batch_results(
+        paths, libcrypt::elgamal_files_signing(params.dh_sys_params, params.user.private_key, paths, 3));
+    check_batch_results(
+        paths, libcrypt::elgamal_check_files_sign(params.dh_sys_params, params.user.shared_key, paths, 3));
+}
+
+TEST_F(SignaturesTest, gost_batch_with_different_files_size)
+{
+    const std::vector<std::filesystem::path> paths = batch_paths();
+    libcrypt::gost_sys_params params = libcrypt::gost_gen_sys();
+
+    check_batch_results(
+        paths,
+        libcrypt::gost_files_signing(
+            params.mod, params.elliptic_exp, params.elliptic_coef, params.user.private_key, paths, 3));
+    check_batch_results(
+        paths,
+        libcrypt::gost_check_files_sign(
+            params.mod, params.elliptic_exp, params.elliptic_coef, params.user.shared_key, paths, 3));
+}
+
+TEST_F(SignaturesTest, batch_check_read_only_files)
+{
+    const std::vector<std::filesystem::path> paths = batch_paths();
+    libcrypt::rsa_sys_params params = libcrypt::rsa_gen_sys();
+
+    check_batch_results(paths, libcrypt::rsa_files_signing(params.private_key, paths, 3));
+
+    for (std::size_t i = 0; i + 1 < paths.size(); i++)
+    {
+        std::filesystem::permissions(paths[i], std::filesystem::perms::owner_read | std::filesystem::perms::group_read);
+    }
+
+    const auto results = libcrypt::rsa_check_files_sign(params.mod, params.user.shared_key, paths, 3);
+
+    for (std::size_t i = 0; i + 1 < paths.size(); i++)
+    {
+        std::filesystem::permissions(
+            paths[i], std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+    }
+
+    check_batch_results(paths, results);
+}
+
 TEST_F(SignaturesTest, anon_voting_on_different_files)
 {
     constexpr uint8_t answer = 1;
@@ -1,5 +1,18 @@
 #include <libcrypt/utils.hpp>
+#include <libcrypt/block_io.hpp>
+#include <libcrypt/byte_table.hpp>
+#include <libcrypt/parallel_search.hpp>
+#include <libcrypt/chunk_pipeline.hpp>
+#include <libcrypt/fixed_base_pow.hpp>
+#include <libcrypt/rsa_crt.hpp>
+#include <libcrypt/rsa_batch_verify.hpp>
+#include <params/params_pool.hpp>
 #include <gtest/gtest.h>
+#include <array>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <utility>
 #include <vector>
 
 TEST(pow_mod, simple)
@@ -54,6 +67,127 @@ TEST(pow_mod, zero_pow_zero)
     EXPECT_EQ(real, expected);
 }
 
+TEST(pow_mod, full_width_mod)
+{
+    constexpr int64_t expected = -6382931201328520790;
+
+    constexpr int64_t base = -37612783631;
+    constexpr int64_t exp = 645813790211;
+    constexpr int64_t mod = 9223372036854775783;
+
+    int64_t real = libcrypt::pow_mod(base, exp, mod);
+
+    EXPECT_EQ(real, expected);
+}
+
+TEST(pow_mod, full_width_even_mod)
+{
+    constexpr int64_t expected = 1332902229479262347;
+
+    constexpr int64_t base = 3;
+    constexpr int64_t exp = 1000000000000000007;
+    constexpr int64_t mod = 4611686018427387904;
+
+    int64_t real = libcrypt::pow_mod(base, exp, mod);
+
+    EXPECT_EQ(real, expected);
+}
+
+TEST(mulmod, full_width)
+{
+    constexpr int64_t expected = 2251749458989488269;
+
+    constexpr int64_t first = 123456789012345678;
+    constexpr int64_t second = 987654321098765432;
+    constexpr int64_t mod = 9223372036854775783;
+
+    int64_t real = libcrypt::mulmod(first, second, mod);
+
+    EXPECT_EQ(real, expected);
+}
+
+TEST(pow_mod, montgomery_matches_plain)
+{
+    constexpr int64_t mod = 64581;
+    const libcrypt::MontgomeryContext ctx(mod);
+
+    for (int64_t base = -300; base <= 300; base += 7)
+    {
+        for (int64_t exp = 0; exp <= 1000; exp += 37)
+        {
+            EXPECT_EQ(libcrypt::pow_mod(base, exp, ctx), libcrypt::pow_mod(base, exp, mod));
+        }
+    }
+}
+
+TEST(pow_mod, modes_match_binary)
+{
+    constexpr std::array<int64_t, 3> mods{64581, 3124312439, 9223372036854775783};
+    constexpr std::array<int64_t, 8> exps{0, 1, 2, 31, 703, 65537, 645813790211, INT64_MAX};
+
+    for (const int64_t mod : mods)
+    {
+        const libcrypt::MontgomeryContext ctx(mod);
+
+        for (const int64_t base : {int64_t{-595}, int64_t{0}, int64_t{2}, int64_t{37612783631}})
+        {
+            for (const int64_t exp : exps)
+            {
+                const int64_t expected = libcrypt::pow_mod(base, exp, ctx);
+
+                EXPECT_EQ(libcrypt::pow_mod(base, exp, ctx, libcrypt::pow_mode::sliding_window), expected)
+                    << mod << ' ' << base << ' ' << exp;
+                EXPECT_EQ(libcrypt::pow_mod(base, exp, ctx, libcrypt::pow_mode::constant_time), expected)
+                    << mod << ' ' << base << ' ' << exp;
+            }
+        }
+    }
+}
+
+TEST(pow_mod, modes_with_even_mod)
+{
+    EXPECT_EQ(
+        libcrypt::pow_mod(595, 703, 64580, libcrypt::pow_mode::sliding_window), libcrypt::pow_mod(595, 703, 64580));
+    EXPECT_ANY_THROW(libcrypt::pow_mod(595, 703, 64580, libcrypt::pow_mode::constant_time));
+    EXPECT_ANY_THROW(libcrypt::pow_mod(595, -1, 64581, libcrypt::pow_mode::sliding_window));
+}
+
+TEST(pow_mod, montgomery_big_mod)
+{
+    constexpr int64_t expected = 6382931201328520790;
+
+    constexpr int64_t base = 37612783631;
+    constexpr int64_t exp = 645813790211;
+    constexpr int64_t mod = 9223372036854775783;
+
+    const libcrypt::MontgomeryContext ctx(mod);
+    int64_t real = libcrypt::pow_mod(base, exp, ctx);
+
+    EXPECT_EQ(real, expected);
+}
+
+TEST(pow_mod, montgomery_even_mod)
+{
+    EXPECT_ANY_THROW(libcrypt::MontgomeryContext{64580});
+}
+
+TEST(byte_decryption_table, more_words_than_bytes)
+{
+    constexpr int64_t mod = 32003 * 32009;
+    constexpr int64_t private_exp = 682880011;
+
+    libcrypt::ByteDecryptionTable decrypt([](int64_t word) { return libcrypt::pow_mod(word, private_exp, mod); });
+
+    // past the first byte_values_num words nothing is cached, the second pass hits both cases
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int32_t word = 1; word <= 1000; ++word)
+        {
+            EXPECT_EQ(decrypt(word), static_cast<char>(libcrypt::pow_mod(word, private_exp, mod))) << word;
+        }
+    }
+}
+
 TEST(extended_gcd, simple)
 {
     const std::vector<int64_t> expected{2, -9, 47};
@@ -99,6 +233,386 @@ TEST(extended_gcd, first_greater_than_second)
     }
 }
 
+TEST(multi_pow_mod, matches_pow_mod)
+{
+    constexpr std::array<int64_t, 4> mods{3124312439, 1000000007, 64580, 2};
+
+    const std::vector<int64_t> bases{595, -17, 1524345121234, 3};
+    const std::vector<int64_t> exps{703, 0, 3124312425, 65537};
+
+    for (const int64_t mod : mods)
+    {
+        for (size_t count = 0; count <= bases.size(); count++)
+        {
+            int64_t expected = libcrypt::mod(1, mod);
+            for (size_t i = 0; i < count; i++)
+            {
+                expected = libcrypt::mulmod(
+                    expected, libcrypt::pow_mod(libcrypt::mod(bases.at(i), mod), exps.at(i), mod), mod);
+            }
+
+            const int64_t real =
+                libcrypt::multi_pow_mod(std::span(bases).first(count), std::span(exps).first(count), mod);
+
+            EXPECT_EQ(real, expected) << mod << ' ' << count;
+        }
+    }
+}
+
+TEST(multi_pow_mod, too_many_bases)
+{
+    const std::vector<int64_t> values(libcrypt::multi_pow_max_bases + 1, 3);
+
+    EXPECT_ANY_THROW(libcrypt::multi_pow_mod(values, values, 1000000007));
+}
+
+TEST(fixed_base_pow, matches_pow_mod)
+{
+    constexpr std::array<int64_t, 3> mods{3124312439, 1000000007, 17179869209};
+    constexpr std::array<int64_t, 7> exps{0, 1, 15, 16, 703, 65537, 3124312425};
+
+    for (const int64_t mod : mods)
+    {
+        const libcrypt::MontgomeryContext ctx(mod);
+
+        for (const int window_bits : {1, 4, 8})
+        {
+            const libcrypt::FixedBasePow base_pow(595, ctx, 32, window_bits);
+
+            for (const int64_t exp : exps)
+            {
+                EXPECT_EQ(base_pow.pow(exp), libcrypt::pow_mod(595, exp, mod)) << mod << ' ' << exp;
+            }
+        }
+    }
+}
+
+TEST(fixed_base_pow, exp_out_of_range)
+{
+    const libcrypt::FixedBasePow base_pow(3, libcrypt::MontgomeryContext(1000000007), 16);
+
+    EXPECT_EQ(base_pow.pow(UINT16_MAX), libcrypt::pow_mod(3, UINT16_MAX, 1000000007));
+    EXPECT_ANY_THROW(base_pow.pow(UINT16_MAX + 1));
+    EXPECT_ANY_THROW(base_pow.pow(-1));
+}
+
+TEST(rsa_crt, matches_pow_mod)
+{
+    constexpr int64_t p = 32003;
+    constexpr int64_t q = 32009;
+    constexpr int64_t private_exp = 682880011;  // 3^(-1) mod (p - 1)(q - 1)
+
+    const libcrypt::RsaCrt crt(libcrypt::make_rsa_private_key(p, q, private_exp));
+
+    EXPECT_EQ(crt.get_mod(), p * q);
+
+    for (const int64_t value : {int64_t{0}, int64_t{1}, int64_t{-128}, int64_t{97}, int64_t{123456789}, p, q * 5})
+    {
+        EXPECT_EQ(crt.pow(value), libcrypt::pow_mod(value, private_exp, p * q)) << value;
+    }
+}
+
+TEST(rsa_crt, equal_factors)
+{
+    EXPECT_ANY_THROW(libcrypt::make_rsa_private_key(32003, 32003, 3));
+}
+
+static void make_rsa_batch(int64_t mod, std::vector<int64_t>& hashes, std::vector<int64_t>& signatures)
+{
+    std::mt19937 mt(7);
+    std::uniform_int_distribution<int64_t> hash_range(2, mod - 1);
+
+    for (int i = 0; i < 200; i++)
+    {
+        // repeated pairs are checked once
+        const int64_t hash = (i % 3 == 0) ? hash_range(mt) : hashes.empty() ? 97 : hashes.back();
+        hashes.emplace_back(hash);
+        signatures.emplace_back(libcrypt::pow_mod(hash, 3, mod));
+    }
+
+    for (const std::size_t i : {7, 150, 151})
+    {
+        signatures[i] = libcrypt::mod(signatures[i] + 1, mod);
+    }
+    signatures[20] = -signatures[20];
+}
+
+TEST(rsa_batch_verify, finds_bad_pairs)
+{
+    constexpr int64_t mod = int64_t{32003} * 32009;
+    constexpr int64_t shared_key = 682880011;  // long enough to be screened, signing with 3
+
+    std::vector<int64_t> hashes;
+    std::vector<int64_t> signatures;
+    make_rsa_batch(mod, hashes, signatures);
+
+    // two signatures negated mod n cancel out in a combined check with odd exponents, not in an exact one
+    signatures[42] = mod - signatures[42];
+    signatures[45] = mod - signatures[45];
+
+    const std::vector<bool> valid = libcrypt::RsaBatchVerifier(mod, shared_key).verify(hashes, signatures);
+
+    ASSERT_EQ(valid.size(), hashes.size());
+    for (std::size_t i = 0; i < valid.size(); i++)
+    {
+        const bool expected = libcrypt::pow_mod(signatures[i], shared_key, mod) == hashes[i];
+        EXPECT_EQ(valid[i], expected) << i;
+    }
+    EXPECT_FALSE(valid[7]);
+    EXPECT_FALSE(valid[20]);
+    EXPECT_TRUE(valid[21]);
+    EXPECT_FALSE(valid[42]);
+    EXPECT_FALSE(valid[45]);
+}
+
+TEST(rsa_batch_verify, screen_finds_bad_pairs)
+{
+    constexpr int64_t mod = int64_t{32003} * 32009;
+    constexpr int64_t shared_key = 682880011;
+
+    std::vector<int64_t> hashes;
+    std::vector<int64_t> signatures;
+    make_rsa_batch(mod, hashes, signatures);
+
+    const std::vector<bool> valid = libcrypt::RsaBatchVerifier(mod, shared_key).screen(hashes, signatures);
+
+    ASSERT_EQ(valid.size(), hashes.size());
+    for (std::size_t i = 0; i < valid.size(); i++)
+    {
+        const bool expected = libcrypt::pow_mod(signatures[i], shared_key, mod) == hashes[i];
+        EXPECT_EQ(valid[i], expected) << i;
+    }
+}
+
+TEST(rsa_batch_verify, short_public_key)
+{
+    constexpr int64_t mod = int64_t{32003} * 32009;
+    constexpr int64_t private_exp = 682880011;
+
+    const std::vector<int64_t> hashes{48, 97, 48, 102, 32003};
+    std::vector<int64_t> signatures;
+    for (const int64_t hash : hashes)
+    {
+        signatures.emplace_back(libcrypt::pow_mod(hash, private_exp, mod));
+    }
+    signatures[3] = 5;
+
+    const std::vector<bool> valid = libcrypt::RsaBatchVerifier(mod, 3).verify(hashes, signatures);
+
+    EXPECT_EQ(valid, (std::vector<bool>{true, true, true, false, true}));
+    EXPECT_ANY_THROW(libcrypt::RsaBatchVerifier(mod, 3).verify(hashes, std::span{signatures}.first(2)));
+}
+
+TEST(xgcd, coefficients_follow_arguments)
+{
+    constexpr int64_t first = 46;
+    constexpr int64_t second = 240;
+
+    const libcrypt::gcd_result real = libcrypt::xgcd(first, second);
+
+    EXPECT_EQ(real.gcd, 2);
+    EXPECT_EQ(real.x, 47);
+    EXPECT_EQ(real.y, -9);
+    EXPECT_EQ(first * real.x + second * real.y, real.gcd);
+}
+
+TEST(binary_gcd, matches_xgcd)
+{
+    constexpr std::array<std::pair<int64_t, int64_t>, 6> pairs{
+        {{240, 46}, {1524345121234, 3124312425}, {0, 17}, {-48, 18}, {1LL << 40, 3LL << 20}, {INT64_MAX, 7}}};
+
+    for (const auto& [first, second] : pairs)
+    {
+        EXPECT_EQ(libcrypt::binary_gcd(first, second), std::abs(libcrypt::xgcd(first, second).gcd))
+            << first << ' ' << second;
+    }
+}
+
+TEST(inverse_mod, simple)
+{
+    EXPECT_EQ(libcrypt::inverse_mod(3, 11), 4);
+    EXPECT_EQ(libcrypt::inverse_mod(-3, 11), 7);
+    EXPECT_EQ(libcrypt::inverse_mod(1524345121234, 3124312439), 70337421);
+    EXPECT_EQ(libcrypt::inverse_mod(6, 9), -1);
+}
+
+TEST(batch_inverse_mod, matches_inverse_mod)
+{
+    constexpr int64_t mod = 3124312439;
+    const std::vector<int64_t> values{1524345121234, 2, -3, 65535, 97, mod - 1, 1};
+
+    std::vector<int64_t> inverses(values.size());
+    libcrypt::batch_inverse_mod(values, inverses, mod);
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        EXPECT_EQ(inverses.at(i), libcrypt::inverse_mod(values.at(i), mod)) << values.at(i);
+    }
+}
+
+TEST(batch_inverse_mod, not_invertible)
+{
+    const std::vector<int64_t> values{3, 6, 5};
+    std::vector<int64_t> inverses(values.size());
+
+    EXPECT_ANY_THROW(libcrypt::batch_inverse_mod(values, inverses, 9));
+}
+
+TEST(is_prime, small_nums)
+{
+    const std::vector<int64_t> primes{2, 3, 5, 47, 53, 2797, 2801, 2803, 65521};
+    const std::vector<int64_t> composites{-7, 0, 1, 4, 9, 2809, 2701, 65535};
+
+    for (const int64_t prime : primes)
+    {
+        EXPECT_TRUE(libcrypt::is_prime(prime)) << prime;
+    }
+
+    for (const int64_t composite : composites)
+    {
+        EXPECT_FALSE(libcrypt::is_prime(composite)) << composite;
+    }
+}
+
+TEST(is_prime, pseudoprimes)
+{
+    // Carmichael numbers and strong pseudoprimes to the smallest bases
+    const std::vector<int64_t> composites{561, 41041, 3215031751, 3825123056546413051};
+
+    for (const int64_t composite : composites)
+    {
+        EXPECT_FALSE(libcrypt::is_prime(composite)) << composite;
+    }
+}
+
+TEST(is_prime, big_nums)
+{
+    const std::vector<int64_t> primes{2147483647, 2305843009213693951, 9223372036854775783};
+    const std::vector<int64_t> composites{2147483647LL * 2147483629LL, 9223372036854775807};
+
+    for (const int64_t prime : primes)
+    {
+        EXPECT_TRUE(libcrypt::is_prime(prime)) << prime;
+    }
+
+    for (const int64_t composite : composites)
+    {
+        EXPECT_FALSE(libcrypt::is_prime(composite)) << composite;
+    }
+}
+
+TEST(gen_germain_prime, is_safe_prime)
+{
+    for (int i = 0; i < 20; i++)
+    {
+        const int64_t germain_prime = libcrypt::gen_germain_prime();
+
+        EXPECT_GE(germain_prime, INT16_MAX);
+        EXPECT_LT(germain_prime, INT32_MAX / 2);
+        EXPECT_TRUE(libcrypt::is_prime(germain_prime)) << germain_prime;
+        EXPECT_TRUE(libcrypt::is_prime(2 * germain_prime + 1)) << germain_prime;
+    }
+}
+
+TEST(gen_germain_prime, multithreaded)
+{
+    const int64_t germain_prime = libcrypt::gen_germain_prime(4);
+
+    EXPECT_TRUE(libcrypt::is_prime(germain_prime)) << germain_prime;
+    EXPECT_TRUE(libcrypt::is_prime(2 * germain_prime + 1)) << germain_prime;
+}
+
+TEST(parallel_search, first_hit_wins)
+{
+    for (unsigned threads_num : {1u, 4u})
+    {
+        const int64_t found = libcrypt::parallel_search(
+            [](std::mt19937& mt) {
+                std::uniform_int_distribution<int64_t> range(0, 99);
+                const int64_t candidate = range(mt);
+                return (candidate % 7 == 0) ? candidate : -1;
+            },
+            threads_num);
+
+        EXPECT_EQ(found % 7, 0) << threads_num;
+    }
+}
+
+TEST(parallel_search, propagates_exception)
+{
+    EXPECT_THROW(libcrypt::parallel_search([](std::mt19937&) -> int64_t { throw std::runtime_error{"failed"}; }, 3),
+                 std::runtime_error);
+}
+
+TEST(chunk_pipeline, keeps_read_order)
+{
+    constexpr int chunks_num = 1000;
+
+    for (const auto& [threads_num, overlap_io] :
+         {std::pair{4U, false}, std::pair{1U, true}, std::pair{3U, true}, std::pair{0U, true}})
+    {
+        int next = 0;
+        std::vector<int> written;
+
+        libcrypt::process_chunks_in_order<int>(
+            threads_num,
+            overlap_io,
+            [&](int& chunk) {
+                chunk = next++;
+                return chunk < chunks_num;
+            },
+            [](int& chunk, unsigned) { chunk *= 2; },
+            [&](int& chunk) { written.push_back(chunk); });
+
+        ASSERT_EQ(written.size(), chunks_num);
+        for (int i = 0; i < chunks_num; i++)
+        {
+            EXPECT_EQ(written[i], 2 * i);
+        }
+    }
+}
+
+TEST(chunk_pipeline, propagates_exception)
+{
+    int next = 0;
+
+    EXPECT_THROW(libcrypt::process_chunks_in_order<int>(
+                     4,
+                     true,
+                     [&](int& chunk) {
+                         chunk = next++;
+                         return chunk < 100;
+                     },
+                     [](int& chunk, unsigned) {
+                         if (chunk == 42)
+                         {
+                             throw std::runtime_error{"failed"};
+                         }
+                     },
+                     [](int&) {}),
+                 std::runtime_error);
+}
+
+TEST(chunk_pipeline, propagates_read_exception)
+{
+    int next = 0;
+
+    EXPECT_THROW(libcrypt::process_chunks_in_order<int>(
+                     2,
+                     true,
+                     [&](int& chunk) {
+                         chunk = next++;
+                         if (chunk == 42)
+                         {
+                             throw std::runtime_error{"failed"};
+                         }
+                         return true;
+                     },
+                     [](int&, unsigned) {},
+                     [](int&) {}),
+                 std::runtime_error);
+}
+
 TEST(baby_step_giant_step, simple)
 {
     constexpr int64_t expected = 832;
@@ -125,6 +639,18 @@ TEST(baby_step_giant_step, big_nums)
     EXPECT_EQ(real, expected);
 }
 
+TEST(baby_step_giant_step, wide_mod)
+{
+    constexpr int64_t base = 3;
+    constexpr int64_t answer = 3828683487;
+    constexpr int64_t mod = 17179869209;
+
+    int64_t real = libcrypt::baby_step_giant_step(base, answer, mod);
+
+    ASSERT_NE(real, -1);
+    EXPECT_EQ(libcrypt::pow_mod(base, real, mod), answer);
+}
+
 TEST(baby_step_giant_step, non_relative_prime_nums)
 {
     constexpr int64_t expected = -1;
@@ -137,3 +663,115 @@ TEST(baby_step_giant_step, non_relative_prime_nums)
 
     EXPECT_EQ(real, expected);
 }
+
+TEST(block_io, round_trip_with_partial_tail)
+{
+    constexpr std::size_t block_size = 3 * sizeof(int32_t);
+
+    const std::vector<int32_t> expected{1, -2, 3, -4, 5, -6, 7};
+
+    std::stringstream stream;
+    {
+        libcrypt::BlockWriter<int32_t> writer(stream, block_size);
+        writer.write(std::span{expected}.first(2));
+        writer.write(std::span{expected}.subspan(2));
+    }
+    stream.write("x", 1);
+
+    std::vector<int32_t> real;
+    libcrypt::BlockReader<int32_t> reader(stream, block_size);
+
+    for (auto block = reader.next(); !block.empty(); block = reader.next())
+    {
+        EXPECT_LE(block.size(), block_size / sizeof(int32_t));
+        real.insert(real.end(), block.begin(), block.end());
+    }
+
+    EXPECT_EQ(real, expected);
+}
+
+TEST(params_pool, take_and_try_take)
+{
+    int64_t generated = 0;
+    libcrypt::ParamsPool<int64_t> pool([&generated] { return generated++; }, 3);
+
+    EXPECT_EQ(pool.take(), 0);
+    EXPECT_EQ(pool.take(), 1);
+
+    while (pool.size() < 3)
+    {
+        std::this_thread::yield();
+    }
+
+    EXPECT_LE(pool.size(), 3);
+    EXPECT_EQ(pool.try_take(), 2);
+}
+
+TEST(params_pool, dh_params)
+{
+    libcrypt::DhParamsPool pool = libcrypt::make_dh_params_pool(2);
+
+    for (int i = 0; i < 3; i++)
+    {
+        const libcrypt::dh_system_params params = pool.take();
+
+        EXPECT_TRUE(libcrypt::is_prime(params.mod)) << params.mod;
+        EXPECT_TRUE(libcrypt::is_prime((params.mod - 1) / 2)) << params.mod;
+    }
+}
+
+TEST(params_pool, propagates_generator_error)
+{
+    int64_t generated = 0;
+    libcrypt::ParamsPool<int64_t> pool(
+        [&generated] {
+            if (generated++ == 0)
+            {
+                throw std::runtime_error{"failed"};
+            }
+            return generated;
+        },
+        1);
+
+    EXPECT_THROW(pool.take(), std::runtime_error);
+    EXPECT_EQ(pool.take(), 2);
+    EXPECT_EQ(pool.take(), 3);
+}
+
+TEST(params_pool, try_take_sees_generator_error)
+{
+    int64_t generated = 0;
+    libcrypt::ParamsPool<int64_t> pool(
+        [&generated] {
+            if (generated++ == 0)
+            {
+                throw std::runtime_error{"failed"};
+            }
+            return generated;
+        },
+        1);
+
+    bool failed = false;
+    std::optional<int64_t> taken;
+
+    while (!taken)
+    {
+        try
+        {
+            taken = pool.try_take();
+        }
+        catch (const std::runtime_error&)
+        {
+            failed = true;
+        }
+        std::this_thread::yield();
+    }
+
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(taken, 2);
+}
+
+TEST(params_pool, zero_capacity)
+{
+    EXPECT_ANY_THROW(libcrypt::ParamsPool<int64_t>([] { return int64_t{1}; }, 0));
+}